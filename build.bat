@@ -15,16 +15,19 @@ if "%~1"=="-Debug" (
 	echo [[ debug build ]]
 	set compilerFlags=%compilerFlags% /Od /MTd /D_DEBUG
 	set rayname=d_raylib
+	set rayflags=/FI ../source/rl_alloc_hooks.h
 )
 if "%~1"=="" (
 	echo [[ debug build ]]
 	set compilerFlags=%compilerFlags% /Od /MTd /D_DEBUG
 	set rayname=d_raylib
+	set rayflags=/FI ../source/rl_alloc_hooks.h
 )
 if "%~1"=="-Release" (
 	echo [[ release build ]]
 	set compilerFlags=%compilerFlags% /O2 /MT 
 	set rayname=raylib
+	set rayflags=
 )
 
 IF NOT EXIST .\build mkdir .\build
@@ -34,7 +37,8 @@ del *.pdb > NUL 2> NUL
 IF NOT EXIST %rayname%.lib (
 echo building raylib
 REM Had to go to platforms directory and change path for GLFW include headers
-cl.exe /w /c /D PLATFORM_DESKTOP /D GRAPHICS_API_OPENGL_33 %compilerFlags% ../external/raylib/*.c
+REM Debug raylib routes RL_MALLOC/RL_FREE through the allocation tracker in Main.cpp
+cl.exe /w /c /D PLATFORM_DESKTOP /D GRAPHICS_API_OPENGL_33 %compilerFlags% %rayflags% ../external/raylib/*.c
 lib /OUT:%rayname%.lib rcore.obj raudio.obj rglfw.obj rmodels.obj rshapes.obj rtext.obj rtextures.obj utils.obj
 del /Q *.obj
 )
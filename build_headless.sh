@@ -0,0 +1,39 @@
+#!/bin/sh
+# Headless Linux build: raylib with the EGL offscreen backend (platforms/rcore_headless.c),
+# runs on Mesa llvmpipe without a display. Usage: ./build_headless.sh [-Debug|-Release]
+# Benchmark from build/: ./Main_headless -bench 600 [-dump 60]
+set -e
+
+command -v g++ >/dev/null || { echo "ERROR: could not find \"g++\""; exit 1; }
+
+warnings="-Wall -Wextra -Wno-unused-parameter -Wno-unused-variable -Wno-missing-field-initializers"
+includes="-I ../external/raylib/"
+linkerLibs="-lEGL -lm -lpthread -ldl"
+compilerFlags="-std=c++20 -mavx2 -ffast-math -fno-rtti -g -DPLATFORM_HEADLESS"
+rayFlags="-std=gnu99 -w -DPLATFORM_HEADLESS -DGRAPHICS_API_OPENGL_33 -D_GNU_SOURCE -mavx2 -g"
+
+if [ "$1" = "-Release" ]; then
+	echo "[[ release build ]]"
+	compilerFlags="$compilerFlags -O2"
+	rayFlags="$rayFlags -O2"
+	rayname=libraylib_headless.a
+else
+	echo "[[ debug build ]]"
+	compilerFlags="$compilerFlags -O0 -D_DEBUG"
+	rayFlags="$rayFlags -O0 -D_DEBUG -include ../source/rl_alloc_hooks.h"
+	rayname=libd_raylib_headless.a
+fi
+
+mkdir -p build
+cd build
+
+if [ ! -f $rayname ]; then
+	echo "building raylib"
+	for module in rcore raudio rmodels rshapes rtext rtextures utils; do
+		gcc $rayFlags -c ../external/raylib/$module.c -o $module.o
+	done
+	ar rcs $rayname rcore.o raudio.o rmodels.o rshapes.o rtext.o rtextures.o utils.o
+	rm -f *.o
+fi
+
+g++ $compilerFlags $warnings $includes ../source/Main.cpp -o Main_headless $rayname $linkerLibs
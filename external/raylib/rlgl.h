@@ -384,6 +384,27 @@ typedef struct rlRenderBatch {
     float currentDepth;         // Current depth value for next draw
 } rlRenderBatch;
 
+// Render batch flush reasons
+typedef enum {
+    RL_FLUSH_EXPLICIT = 0,      // End of frame, state change (matrix, shader, blend...) or user request
+    RL_FLUSH_MODE_CHANGE,       // Draw calls limit reached on a primitive mode change
+    RL_FLUSH_TEXTURE_CHANGE,    // Draw calls limit reached on a texture change
+    RL_FLUSH_BUFFER_FULL,       // Vertex buffer full
+    RL_FLUSH_REASON_COUNT
+} rlFlushReason;
+
+// Render batch statistics, accumulated until rlResetRenderStats()
+typedef struct rlRenderStats {
+    int drawCalls;              // Draw calls issued (glDrawArrays/glDrawElements)
+    int vertices;               // Vertices submitted
+    int flushes;                // Render batch flushes with vertex data
+    int flushReasons[RL_FLUSH_REASON_COUNT]; // Flushes per rlFlushReason
+    int modeBreaks;             // Draw calls split by a primitive mode change
+    int textureBreaks;          // Draw calls split by a texture change
+    int bufferUploads;          // Vertex buffer uploads (glBufferSubData)
+    int uploadBytes;            // Vertex data uploaded in bytes
+} rlRenderStats;
+
 // OpenGL version
 typedef enum {
     RL_OPENGL_11 = 1,           // OpenGL 1.1
@@ -677,6 +698,8 @@ RLAPI void rlDrawRenderBatch(rlRenderBatch *batch);                         // D
 RLAPI void rlSetRenderBatchActive(rlRenderBatch *batch);                    // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);                                   // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);                             // Check internal buffer overflow for a given number of vertex
+RLAPI rlRenderStats rlGetRenderStats(void);                                 // Get render batch statistics
+RLAPI void rlResetRenderStats(void);                                        // Reset render batch statistics
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
 
@@ -710,6 +733,15 @@ RLAPI void rlGenTextureMipmaps(unsigned int id, int width, int height, int forma
 RLAPI void *rlReadTexturePixels(unsigned int id, int width, int height, int format);              // Read texture pixel data
 RLAPI unsigned char *rlReadScreenPixels(int width, int height);           // Read screen pixel data (color buffer)
 
+// Asynchronous screen readback through pixel pack buffers (OpenGL 3.3 only, no-op elsewhere)
+RLAPI unsigned int rlLoadPixelBuffer(int size);                           // Load pixel pack buffer of size bytes
+RLAPI void rlUnloadPixelBuffer(unsigned int id);                          // Unload pixel pack buffer
+RLAPI void *rlReadScreenPixelsAsync(unsigned int id, int width, int height); // Start color buffer copy into pixel buffer, returns a sync fence
+RLAPI bool rlIsSyncSignaled(void *sync);                                  // Check if GPU reached the fence, does not wait
+RLAPI void rlUnloadSync(void *sync);                                      // Unload sync fence
+RLAPI const unsigned char *rlMapPixelBuffer(unsigned int id, int size);   // Map pixel buffer for reading (rows bottom-up), NULL on failure
+RLAPI void rlUnmapPixelBuffer(void);                                      // Unmap pixel buffer mapped with rlMapPixelBuffer()
+
 // Framebuffer management (fbo)
 RLAPI unsigned int rlLoadFramebuffer(int width, int height);              // Load an empty framebuffer
 RLAPI void rlFramebufferAttach(unsigned int fboId, unsigned int texId, int attachType, int texType, int mipLevel);  // Attach texture/renderbuffer to a framebuffer
@@ -1033,6 +1065,9 @@ typedef struct rlglData {
         int maxDepthBits;                   // Maximum bits for depth component
 
     } ExtSupported;     // Extensions supported flags
+
+    rlRenderStats stats;                    // Render batch statistics
+    int flushReason;                        // Reason for the next rlDrawRenderBatch() (rlFlushReason)
 } rlglData;
 
 typedef void *(*rlglLoadProc)(const char *name);   // OpenGL extension functions loader signature (same as GLADloadproc)
@@ -1366,10 +1401,15 @@ void rlBegin(int mode)
             {
                 RLGL.State.vertexCounter += RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexAlignment;
                 RLGL.currentBatch->drawCounter++;
+                RLGL.stats.modeBreaks++;
             }
         }
 
-        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+        {
+            RLGL.flushReason = RL_FLUSH_MODE_CHANGE;
+            rlDrawRenderBatch(RLGL.currentBatch);
+        }
 
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -1516,6 +1556,7 @@ void rlSetTexture(unsigned int id)
         if (RLGL.State.vertexCounter >=
             RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4)
         {
+            RLGL.flushReason = RL_FLUSH_BUFFER_FULL;
             rlDrawRenderBatch(RLGL.currentBatch);
         }
 #endif
@@ -1543,10 +1584,15 @@ void rlSetTexture(unsigned int id)
                     RLGL.State.vertexCounter += RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexAlignment;
 
                     RLGL.currentBatch->drawCounter++;
+                    RLGL.stats.textureBreaks++;
                 }
             }
 
-            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+            {
+                RLGL.flushReason = RL_FLUSH_TEXTURE_CHANGE;
+                rlDrawRenderBatch(RLGL.currentBatch);
+            }
 
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = id;
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -2730,6 +2776,11 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
     // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (use a change detector flag?)
     if (RLGL.State.vertexCounter > 0)
     {
+        RLGL.stats.flushes++;
+        RLGL.stats.flushReasons[RLGL.flushReason]++;
+        RLGL.stats.bufferUploads += 3;
+        RLGL.stats.uploadBytes += RLGL.State.vertexCounter*(3*sizeof(float) + 2*sizeof(float) + 4*sizeof(unsigned char));
+
         // Activate elements VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
 
@@ -2850,6 +2901,9 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
                 // Bind current draw call texture, activated as GL_TEXTURE0 and Bound to sampler2D texture0 by default
                 glBindTexture(GL_TEXTURE_2D, batch->draws[i].textureId);
 
+                RLGL.stats.drawCalls++;
+                RLGL.stats.vertices += batch->draws[i].vertexCount;
+
                 if ((batch->draws[i].mode == RL_LINES) || (batch->draws[i].mode == RL_TRIANGLES)) glDrawArrays(batch->draws[i].mode, vertexOffset, batch->draws[i].vertexCount);
                 else
                 {
@@ -2889,6 +2943,7 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
     //------------------------------------------------------------------------------------------------------------
     // Reset vertex counter for next frame
     RLGL.State.vertexCounter = 0;
+    RLGL.flushReason = RL_FLUSH_EXPLICIT;
 
     // Reset depth for next draw
     batch->currentDepth = -1.0f;
@@ -2937,6 +2992,25 @@ void rlDrawRenderBatchActive(void)
 #endif
 }
 
+// Get render batch statistics
+rlRenderStats rlGetRenderStats(void)
+{
+    rlRenderStats stats = { 0 };
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    stats = RLGL.stats;
+#endif
+    return stats;
+}
+
+// Reset render batch statistics
+void rlResetRenderStats(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    rlRenderStats empty = { 0 };
+    RLGL.stats = empty;
+#endif
+}
+
 // Check internal buffer overflow for a given number of vertex
 // and force a rlRenderBatch draw call if required
 bool rlCheckRenderBatchLimit(int vCount)
@@ -2953,6 +3027,7 @@ bool rlCheckRenderBatchLimit(int vCount)
         int currentMode = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode;
         int currentTexture = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId;
 
+        RLGL.flushReason = RL_FLUSH_BUFFER_FULL;
         rlDrawRenderBatch(RLGL.currentBatch);    // NOTE: Stereo rendering is checked inside
 
         // Restore state of last batch so we can continue adding vertices
@@ -3472,6 +3547,84 @@ unsigned char *rlReadScreenPixels(int width, int height)
     return imgData;     // NOTE: image data should be freed
 }
 
+// Load pixel pack buffer of size bytes
+unsigned int rlLoadPixelBuffer(int size)
+{
+    unsigned int id = 0;
+#if defined(GRAPHICS_API_OPENGL_33)
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+    return id;
+}
+
+// Unload pixel pack buffer
+void rlUnloadPixelBuffer(unsigned int id)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    glDeleteBuffers(1, &id);
+#endif
+}
+
+// Start color buffer copy into pixel buffer, returns a sync fence
+// NOTE: The copy runs on the GPU, map the buffer once the fence is signaled to avoid stalling
+void *rlReadScreenPixelsAsync(unsigned int id, int width, int height)
+{
+    void *sync = NULL;
+#if defined(GRAPHICS_API_OPENGL_33)
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    sync = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+    return sync;
+}
+
+// Check if GPU reached the fence, does not wait
+bool rlIsSyncSignaled(void *sync)
+{
+    bool result = false;
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (sync != NULL)
+    {
+        GLenum status = glClientWaitSync((GLsync)sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        result = (status == GL_ALREADY_SIGNALED) || (status == GL_CONDITION_SATISFIED);
+    }
+#endif
+    return result;
+}
+
+// Unload sync fence
+void rlUnloadSync(void *sync)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (sync != NULL) glDeleteSync((GLsync)sync);
+#endif
+}
+
+// Map pixel buffer for reading (rows bottom-up)
+const unsigned char *rlMapPixelBuffer(unsigned int id, int size)
+{
+    const unsigned char *data = NULL;
+#if defined(GRAPHICS_API_OPENGL_33)
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    data = (const unsigned char *)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (data == NULL) glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);    // Nothing to unmap, leave no buffer bound
+#endif
+    return data;
+}
+
+// Unmap pixel buffer mapped with rlMapPixelBuffer()
+void rlUnmapPixelBuffer(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+}
+
 // Framebuffer management (fbo)
 //-----------------------------------------------------------------------------------------
 // Load a framebuffer to be used for rendering
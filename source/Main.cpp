@@ -1,15 +1,30 @@
-﻿#include <vector>
+﻿#define _CRT_SECURE_NO_WARNINGS // fopen
+#include <vector>
 #include <algorithm>
 #include <functional> 
 #include <memory>
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
+#include <cstdio>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <malloc.h>
+#include <thread>
+#include <span>
 
 #include <raylib.h>
 #include <raymath.h>
+#include <rlgl.h>
+#include <external/qoi.h>      // encoders compiled into raylib
+#include <external/msf_gif.h>
 
 bool isPaused = false;
+// Seconds of play, stands still while paused. Asteroids and projectiles are evaluated against it
+// instead of being stepped, so pausing does not touch them.
+double gameTime = 0.0;
 
 float sgn(float x) {
 	if (x < 0) {
@@ -23,90 +38,1883 @@ namespace Utils {
 	inline static float RandomFloat(float min, float max) {
 		return min + static_cast<float>(rand()) / RAND_MAX * (max - min);
 	}
+
+	// Seconds until a point moving at constant velocity leaves the rectangle, infinite if it never does
+	inline static double ExitTime(Vector2 p, Vector2 v, const Rectangle& r) {
+		if (p.x < r.x || p.x > r.x + r.width || p.y < r.y || p.y > r.y + r.height) return 0.0;
+		double t = INFINITY;
+		if (v.x > 0.f) t = std::min(t, static_cast<double>((r.x + r.width - p.x) / v.x));
+		if (v.x < 0.f) t = std::min(t, static_cast<double>((r.x - p.x) / v.x));
+		if (v.y > 0.f) t = std::min(t, static_cast<double>((r.y + r.height - p.y) / v.y));
+		if (v.y < 0.f) t = std::min(t, static_cast<double>((r.y - p.y) / v.y));
+		return t;
+	}
 }
 
-// --- TRANSFORM, PHYSICS, LIFETIME, RENDERABLE ---
-struct TransformA {
-	Vector2 position{};
-	float rotation{};
+// --- FRAME PHASES ---
+enum class FramePhase { INPUT = 0, SPAWN, UPDATE, COLLISION, AUDIO, RENDER, COUNT };
+
+static constexpr const char* FRAME_PHASE_NAMES[static_cast<int>(FramePhase::COUNT)] = {
+	"input", "spawn", "update", "collision", "audio", "render"
+};
+
+// --- ALLOCATION TRACKING ---
+// Enabled by default in debug builds, counts every C++ and raylib heap allocation.
+// Per-frame/per-phase numbers only count the game thread, heap size counts all threads.
+#ifndef ALLOC_TRACKING
+#ifdef _DEBUG
+#define ALLOC_TRACKING 1
+#else
+#define ALLOC_TRACKING 0
+#endif
+#endif
+
+#ifdef _WIN32
+#define ALLOC_USABLE_SIZE(p) _msize(p)
+#else
+#define ALLOC_USABLE_SIZE(p) malloc_usable_size(p)
+#endif
+
+struct AllocCounters {
+	uint64_t allocs = 0;
+	uint64_t frees = 0;
+	uint64_t bytes = 0;
+	int64_t peak = 0;      // heap size high-water mark seen by the game thread
+};
+
+class AllocTracker {
+public:
+	static AllocTracker& Instance() {
+		static AllocTracker inst;
+		return inst;
+	}
+
+	// Frames after the last transition that count as steady state
+	static constexpr int C_WARMUP_FRAMES = 60;
+
+	void AttachGameThread() {
+		gameThread = true;
+	}
+
+	// Abort on any game thread allocation during steady-state frames
+	void SetAssertSteady(bool on) {
+		assertSteady = on;
+	}
+
+	// Startup, restart and similar frames are allowed to allocate
+	void MarkTransition() {
+		steadyIn = C_WARMUP_FRAMES;
+		steady = false;
+	}
+
+	void BeginFrame() {
+		for (AllocCounters& c : phases) c = {};
+		phase = FramePhase::INPUT;
+		framePeak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		phases[static_cast<int>(phase)].peak = live.load(std::memory_order_relaxed);
+		steady = steadyIn == 0;
+		if (steadyIn > 0) steadyIn--;
+	}
+
+	void Phase(FramePhase p) {
+		phase = p;
+		AllocCounters& c = phases[static_cast<int>(phase)];
+		c.peak = std::max(c.peak, live.load(std::memory_order_relaxed));
+	}
+
+	// Code we do not own (GL driver, shader JIT) may allocate through our operator new,
+	// such allocations only count towards the heap size
+	void BeginExternal() {
+		external++;
+	}
+
+	void EndExternal() {
+		external--;
+	}
+
+	// Mesa's llvmpipe JIT on the headless Linux build allocates through our operator new inside
+	// buffer swaps and readbacks. Other platforms' drivers use their own heap, so there the
+	// same calls stay subject to -noalloc.
+	void BeginDriver() {
+#ifdef PLATFORM_HEADLESS
+		BeginExternal();
+#endif
+	}
+
+	void EndDriver() {
+#ifdef PLATFORM_HEADLESS
+		EndExternal();
+#endif
+	}
+
+	void EndFrame() {
+		lastFrame = {};
+		for (int i = 0; i < static_cast<int>(FramePhase::COUNT); ++i) {
+			lastPhases[i] = phases[i];
+			lastFrame.allocs += phases[i].allocs;
+			lastFrame.frees += phases[i].frees;
+			lastFrame.bytes += phases[i].bytes;
+			lastFrame.peak = std::max(lastFrame.peak, phases[i].peak);
+		}
+		lastFramePeak = framePeak.load(std::memory_order_relaxed);
+		worstFrameAllocs = std::max(worstFrameAllocs, lastFrame.allocs);
+		if (steady) {
+			steadyFrames++;
+			steadyAllocs += lastFrame.allocs;
+		}
+	}
+
+	void OnAlloc(void* p) {
+		if (!p) return;
+		int64_t size = static_cast<int64_t>(ALLOC_USABLE_SIZE(p));
+		int64_t now = live.fetch_add(size, std::memory_order_relaxed) + size;
+		UpdateMax(peak, now);
+		UpdateMax(framePeak, now);
+		if (!gameThread) return;
+		AllocCounters& c = phases[static_cast<int>(phase)];
+		c.peak = std::max(c.peak, now);
+		if (external > 0) {
+			externalAllocs++;
+			return;
+		}
+		c.allocs++;
+		c.bytes += size;
+		if (assertSteady && steady && !failing) Fail(size);
+	}
+
+	void OnFree(void* p) {
+		if (!p) return;
+		live.fetch_sub(static_cast<int64_t>(ALLOC_USABLE_SIZE(p)), std::memory_order_relaxed);
+		if (gameThread && external == 0) phases[static_cast<int>(phase)].frees++;
+	}
+
+	const AllocCounters& LastFrame() const { return lastFrame; }
+	const AllocCounters& LastPhase(FramePhase p) const { return lastPhases[static_cast<int>(p)]; }
+	int64_t LiveBytes() const { return live.load(std::memory_order_relaxed); }
+	int64_t PeakBytes() const { return peak.load(std::memory_order_relaxed); }
+	int64_t LastFramePeakBytes() const { return lastFramePeak; }
+	bool IsSteady() const { return steady; }
+
+	void Report() const {
+		TraceLog(LOG_INFO, "ALLOC: tracking %s, peak heap %lld KB, worst frame %llu allocs",
+			ALLOC_TRACKING ? "on" : "off", static_cast<long long>(PeakBytes() / 1024),
+			static_cast<unsigned long long>(worstFrameAllocs));
+		TraceLog(LOG_INFO, "ALLOC: %llu allocs over %llu steady-state frames, %llu external (driver)",
+			static_cast<unsigned long long>(steadyAllocs), static_cast<unsigned long long>(steadyFrames),
+			static_cast<unsigned long long>(externalAllocs));
+	}
+
+private:
+	AllocTracker() = default;
+
+	static void UpdateMax(std::atomic<int64_t>& target, int64_t value) {
+		int64_t cur = target.load(std::memory_order_relaxed);
+		while (value > cur && !target.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+	}
+
+	void Fail(int64_t size) {
+		failing = true;
+		TraceLog(LOG_ERROR, "ALLOC: %lld bytes allocated in steady-state frame, phase '%s'",
+			static_cast<long long>(size), FRAME_PHASE_NAMES[static_cast<int>(phase)]);
+		abort();
+	}
+
+	static inline thread_local bool gameThread = false;
+
+	std::atomic<int64_t> live{ 0 };
+	std::atomic<int64_t> peak{ 0 };
+	std::atomic<int64_t> framePeak{ 0 };
+
+	// Game thread only
+	AllocCounters phases[static_cast<int>(FramePhase::COUNT)];
+	AllocCounters lastPhases[static_cast<int>(FramePhase::COUNT)];
+	AllocCounters lastFrame;
+	FramePhase phase = FramePhase::INPUT;
+	int64_t lastFramePeak = 0;
+	uint64_t worstFrameAllocs = 0;
+	uint64_t steadyFrames = 0;
+	uint64_t steadyAllocs = 0;
+	uint64_t externalAllocs = 0;
+	int steadyIn = C_WARMUP_FRAMES;
+	int external = 0;
+	bool steady = false;
+	bool assertSteady = false;
+	bool failing = false;
+};
+
+// raylib side, see rl_alloc_hooks.h
+extern "C" {
+	void* TrackedMalloc(size_t size) {
+		void* p = malloc(size);
+#if ALLOC_TRACKING
+		AllocTracker::Instance().OnAlloc(p);
+#endif
+		return p;
+	}
+	void* TrackedCalloc(size_t count, size_t size) {
+		void* p = calloc(count, size);
+#if ALLOC_TRACKING
+		AllocTracker::Instance().OnAlloc(p);
+#endif
+		return p;
+	}
+	void* TrackedRealloc(void* ptr, size_t size) {
+#if ALLOC_TRACKING
+		AllocTracker::Instance().OnFree(ptr);
+#endif
+		void* p = realloc(ptr, size);
+#if ALLOC_TRACKING
+		// A failed realloc keeps the old block alive
+		AllocTracker::Instance().OnAlloc((p || size == 0) ? p : ptr);
+#endif
+		return p;
+	}
+	void TrackedFree(void* ptr) {
+#if ALLOC_TRACKING
+		AllocTracker::Instance().OnFree(ptr);
+#endif
+		free(ptr);
+	}
+}
+
+#if ALLOC_TRACKING
+void* operator new(size_t size) {
+	void* p = malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	AllocTracker::Instance().OnAlloc(p);
+	return p;
+}
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+void operator delete(void* p) noexcept {
+	AllocTracker::Instance().OnFree(p);
+	free(p);
+}
+void operator delete[](void* p) noexcept {
+	operator delete(p);
+}
+void operator delete(void* p, size_t) noexcept {
+	operator delete(p);
+}
+void operator delete[](void* p, size_t) noexcept {
+	operator delete(p);
+}
+#endif
+
+// Fixed-size block pool, hands out blocks from a free list and falls back to the heap when exhausted
+template <size_t BlockSize, size_t Count>
+class BlockPool {
+public:
+	BlockPool() {
+		for (size_t i = 0; i < Count; ++i) {
+			Block* b = reinterpret_cast<Block*>(storage + i * C_STRIDE);
+			b->next = freeList;
+			freeList = b;
+		}
+	}
+
+	void* Alloc(size_t size) {
+		if (size > BlockSize || !freeList) return ::operator new(size);
+		Block* b = freeList;
+		freeList = b->next;
+		return b;
+	}
+
+	void Free(void* p) {
+		unsigned char* c = static_cast<unsigned char*>(p);
+		if (c < storage || c >= storage + sizeof(storage)) {
+			::operator delete(p);
+			return;
+		}
+		Block* b = static_cast<Block*>(p);
+		b->next = freeList;
+		freeList = b;
+	}
+
+private:
+	struct Block {
+		Block* next;
+	};
+
+	static constexpr size_t C_STRIDE = (BlockSize + 15) & ~static_cast<size_t>(15);
+
+	alignas(16) unsigned char storage[C_STRIDE * Count];
+	Block* freeList = nullptr;
+};
+
+// --- EXIT QUEUE ---
+// Objects that leave at a planned game time. Items stay dense for iteration, an indexed min-heap
+// on exit time finds the ones due without touching the rest. Push, Remove and retiring are O(log n),
+// removal moves the last item into the hole so item order is not kept. Heap entries carry a copy of
+// the exit time, so sifting never reads the items.
+template <typename T, typename ExitOf>
+class ExitQueue {
+public:
+	void Reserve(size_t n) {
+		items.reserve(n);
+		heapAt.reserve(n);
+		heap.reserve(n);
+	}
+
+	size_t Size() const {
+		return items.size();
+	}
+
+	T& operator[](size_t i) {
+		return items[i];
+	}
+
+	const T& operator[](size_t i) const {
+		return items[i];
+	}
+
+	auto begin() { return items.begin(); }
+	auto end() { return items.end(); }
+	auto begin() const { return items.begin(); }
+	auto end() const { return items.end(); }
+
+	void Push(T item) {
+		uint32_t i = static_cast<uint32_t>(items.size());
+		double exit = ExitOf()(item);
+		items.push_back(std::move(item));
+		heapAt.push_back(static_cast<uint32_t>(heap.size()));
+		heap.push_back({ exit, i });
+		SiftUp(heap.size() - 1);
+	}
+
+	// Bulk add: items are appended in one go, then the heap is rebuilt when the batch is large
+	// compared to what is queued, otherwise the new entries are sifted up
+	void Append(std::span<const T> batch) {
+		size_t first = items.size();
+		items.insert(items.end(), batch.begin(), batch.end());
+		for (size_t i = first; i < items.size(); ++i) {
+			heapAt.push_back(static_cast<uint32_t>(heap.size()));
+			heap.push_back({ ExitOf()(items[i]), static_cast<uint32_t>(i) });
+		}
+		if (batch.size() > first / 2) {
+			Heapify();
+		}
+		else {
+			for (size_t h = heap.size() - batch.size(); h < heap.size(); ++h) {
+				SiftUp(h);
+			}
+		}
+	}
+
+	void Remove(size_t i) {
+		size_t h = heapAt[i];
+		Entry moved = heap.back();
+		heap.pop_back();
+		if (h < heap.size()) {
+			Place(h, moved);
+			if (h > 0 && moved.exit < heap[(h - 1) / 2].exit) SiftUp(h);
+			else SiftDown(h);
+		}
+		size_t last = items.size() - 1;
+		if (i != last) {
+			items[i] = std::move(items[last]);
+			heap[heapAt[last]].item = static_cast<uint32_t>(i);
+			heapAt[i] = heapAt[last];
+		}
+		items.pop_back();
+		heapAt.pop_back();
+	}
+
+	// Removes every item whose exit time has passed, `retire` sees each one first
+	template <typename F>
+	void RetireUntil(double now, F&& retire) {
+		while (!heap.empty() && heap[0].exit <= now) {
+			retire(items[heap[0].item]);
+			Remove(heap[0].item);
+		}
+	}
+
+	void RetireUntil(double now) {
+		RetireUntil(now, [](const T&) {});
+	}
+
+	// Call after changing exit times of items in place
+	void Rebuild() {
+		for (Entry& e : heap) {
+			e.exit = ExitOf()(items[e.item]);
+		}
+		Heapify();
+	}
+
+	void Clear() {
+		items.clear();
+		heapAt.clear();
+		heap.clear();
+	}
+
+private:
+	struct Entry {
+		double exit;
+		uint32_t item;
+	};
+
+	void Heapify() {
+		for (size_t h = heap.size() / 2; h-- > 0;) {
+			SiftDown(h);
+		}
+	}
+
+	void Place(size_t h, const Entry& e) {
+		heap[h] = e;
+		heapAt[e.item] = static_cast<uint32_t>(h);
+	}
+
+	void SiftUp(size_t h) {
+		Entry e = heap[h];
+		while (h > 0) {
+			size_t parent = (h - 1) / 2;
+			if (heap[parent].exit <= e.exit) break;
+			Place(h, heap[parent]);
+			h = parent;
+		}
+		Place(h, e);
+	}
+
+	void SiftDown(size_t h) {
+		Entry e = heap[h];
+		for (;;) {
+			size_t child = 2 * h + 1;
+			if (child >= heap.size()) break;
+			if (child + 1 < heap.size() && heap[child + 1].exit < heap[child].exit) ++child;
+			if (e.exit <= heap[child].exit) break;
+			Place(h, heap[child]);
+			h = child;
+		}
+		Place(h, e);
+	}
+
+	std::vector<T> items;
+	std::vector<uint32_t> heapAt;   // heap position of each item
+	std::vector<Entry> heap;
+};
+
+// --- FRAME GOVERNOR ---
+// Sheds work when frames run over budget. Phase times are smoothed, the level goes up one step after
+// a run of heavy frames and comes back down only after a long run well under budget, with a hold
+// after every change so the two never flap. Each level keeps the measures of the levels below it.
+enum class GovernorLevel : uint8_t { FULL = 0, SPAWNS, ENEMY_FIRE, SIMPLE_DRAWS, COLLISION, COUNT };
+
+static constexpr const char* GOVERNOR_LEVEL_NAMES[static_cast<int>(GovernorLevel::COUNT)] = {
+	"full", "throttled spawns", "capped enemy fire", "simple bullet draws", "coarse far collisions"
+};
+
+class FrameGovernor {
+public:
+	static FrameGovernor& Instance() {
+		static FrameGovernor inst;
+		return inst;
+	}
+
+	// A zero budget turns the governor off
+	void Configure(double budgetSeconds, GovernorLevel maxLevel) {
+		budget = budgetSeconds;
+		ceiling = maxLevel;
+	}
+
+	void BeginFrame() {
+		for (double& s : spent) s = 0.0;
+		phase = FramePhase::INPUT;
+		phaseStart = GetTime();
+	}
+
+	void Phase(FramePhase p) {
+		double now = GetTime();
+		spent[static_cast<int>(phase)] += now - phaseStart;
+		phase = p;
+		phaseStart = now;
+	}
+
+	// `limiterSeconds` is the frame limiter wait inside the render phase, it is not work
+	void EndFrame(double limiterSeconds) {
+		Phase(phase);
+		int render = static_cast<int>(FramePhase::RENDER);
+		spent[render] = std::max(0.0, spent[render] - limiterSeconds);
+		double total = 0.0;
+		for (int i = 0; i < static_cast<int>(FramePhase::COUNT); ++i) {
+			smoothed[i] += (spent[i] - smoothed[i]) * C_SMOOTHING;
+			total += spent[i];
+		}
+		smoothedTotal += (total - smoothedTotal) * C_SMOOTHING;
+		framesAt[static_cast<int>(level)]++;
+
+		if (budget <= 0.0) return;
+		if (hold > 0) {
+			hold--;
+			return;
+		}
+		if (smoothedTotal > budget) {
+			under = 0;
+			if (++over >= C_UP_FRAMES && level < ceiling) Change(1);
+		}
+		else if (smoothedTotal < budget * C_RECOVER) {
+			over = 0;
+			if (++under >= C_DOWN_FRAMES && level > GovernorLevel::FULL) Change(-1);
+		}
+		else {
+			over = 0;
+			under = 0;
+		}
+	}
+
+	bool Applies(GovernorLevel l) const {
+		return level >= l;
+	}
+
+	GovernorLevel Level() const {
+		return level;
+	}
+
+	const char* Reason() const {
+		return reason;
+	}
+
+	double Budget() const {
+		return budget;
+	}
+
+	double SmoothedSeconds() const {
+		return smoothedTotal;
+	}
+
+	int Changes() const {
+		return changes;
+	}
+
+	int FramesAt(GovernorLevel l) const {
+		return framesAt[static_cast<int>(l)];
+	}
+
+	void Reset() {
+		level = GovernorLevel::FULL;
+		snprintf(reason, sizeof(reason), "within budget");
+		over = 0;
+		under = 0;
+		hold = 0;
+		changes = 0;
+		for (int& f : framesAt) f = 0;
+	}
+
+private:
+	static constexpr double C_SMOOTHING = 0.1;     // weight of the newest frame
+	static constexpr double C_RECOVER = 0.7;       // step down only well under budget
+	static constexpr int C_UP_FRAMES = 15;
+	static constexpr int C_DOWN_FRAMES = 120;
+	static constexpr int C_HOLD_FRAMES = 60;
+
+	FrameGovernor() {
+		Reset();
+	}
+
+	void Change(int step) {
+		int heaviest = 0;
+		for (int i = 1; i < static_cast<int>(FramePhase::COUNT); ++i) {
+			if (smoothed[i] > smoothed[heaviest]) heaviest = i;
+		}
+		level = static_cast<GovernorLevel>(static_cast<int>(level) + step);
+		snprintf(reason, sizeof(reason), "frame %.2f ms %s %.2f ms budget, %s %.2f ms", 1000.0 * smoothedTotal,
+			step > 0 ? "over" : "under", 1000.0 * budget, FRAME_PHASE_NAMES[heaviest], 1000.0 * smoothed[heaviest]);
+		TraceLog(LOG_INFO, "GOVERNOR: Level %d (%s), %s", static_cast<int>(level),
+			GOVERNOR_LEVEL_NAMES[static_cast<int>(level)], reason);
+		hold = C_HOLD_FRAMES;
+		over = 0;
+		under = 0;
+		changes++;
+	}
+
+	double budget = 0.0;
+	GovernorLevel ceiling = GovernorLevel::COLLISION;
+	GovernorLevel level = GovernorLevel::FULL;
+	char reason[128]{};
+	FramePhase phase = FramePhase::INPUT;
+	double phaseStart = 0.0;
+	double spent[static_cast<int>(FramePhase::COUNT)]{};
+	double smoothed[static_cast<int>(FramePhase::COUNT)]{};
+	double smoothedTotal = 0.0;
+	int over = 0;
+	int under = 0;
+	int hold = 0;
+	int changes = 0;
+	int framesAt[static_cast<int>(GovernorLevel::COUNT)]{};
+};
+
+// --- TIMER WHEEL ---
+using TimerId = uint32_t;
+using TimerFn = void (*)(void* ctx, uintptr_t arg);
+
+// Hierarchical timing wheel on game time. Schedule and Cancel are O(1); advancing visits one slot
+// per tick and only the timers due in it, far timers are cascaded down when their coarse slot comes up.
+class TimerWheel {
+public:
+	static TimerWheel& Instance() {
+		static TimerWheel inst;
+		return inst;
+	}
+
+	// Call fn(ctx, arg) once after delay seconds
+	TimerId Schedule(float delay, TimerFn fn, void* ctx, uintptr_t arg) {
+		return Add(ToTicks(delay), 0, 1, fn, ctx, arg);
+	}
+
+	// Call fn(ctx, arg) every interval seconds, count times (0 = until cancelled)
+	TimerId ScheduleRepeating(float interval, int count, TimerFn fn, void* ctx, uintptr_t arg) {
+		uint32_t ticks = ToTicks(interval);
+		return Add(ticks, ticks, count, fn, ctx, arg);
+	}
+
+	// Stale ids (fired or already cancelled) are ignored
+	void Cancel(TimerId id) {
+		Timer* t = Lookup(id);
+		if (!t) return;
+		Unlink(t);
+		Release(t);
+	}
+
+	void Advance(float dt) {
+		pending += static_cast<double>(dt) * C_TICKS_PER_SECOND;
+		while (pending >= 1.0) {
+			pending -= 1.0;
+			Tick();
+		}
+	}
+
+	void Clear() {
+		for (Timer*& head : slots) {
+			while (head) {
+				Timer* t = head;
+				Unlink(t);
+				Release(t);
+			}
+		}
+		pending = 0.0;
+	}
+
+	int Active() const {
+		return active;
+	}
+
+private:
+	struct Timer {
+		uint64_t due;
+		uint32_t interval;
+		int remaining;
+		TimerFn fn;
+		void* ctx;
+		uintptr_t arg;
+		Timer* prev;
+		Timer* next;
+		uint16_t slot;
+		uint16_t generation;
+	};
+
+	TimerWheel() {
+		for (size_t i = C_CAPACITY; i-- > 0;) {
+			timers[i].next = freeList;
+			freeList = &timers[i];
+		}
+	}
+
+	static uint32_t ToTicks(float seconds) {
+		float ticks = ceilf(seconds * C_TICKS_PER_SECOND);
+		return ticks < 1.f ? 1u : static_cast<uint32_t>(fminf(ticks, static_cast<float>(C_MAX_TICKS)));
+	}
+
+	TimerId Add(uint32_t delay, uint32_t interval, int count, TimerFn fn, void* ctx, uintptr_t arg) {
+		if (!freeList) {
+			TraceLog(LOG_WARNING, "TIMER: All %d timers in use, event dropped", static_cast<int>(C_CAPACITY));
+			return 0;
+		}
+		Timer* t = freeList;
+		freeList = t->next;
+		t->due = now + delay;
+		t->interval = interval;
+		t->remaining = count;
+		t->fn = fn;
+		t->ctx = ctx;
+		t->arg = arg;
+		Link(t);
+		active++;
+		size_t index = static_cast<size_t>(t - timers);
+		return (static_cast<TimerId>(t->generation) << 16) | static_cast<TimerId>(index + 1);
+	}
+
+	Timer* Lookup(TimerId id) {
+		size_t index = (id & 0xFFFF);
+		if (index == 0 || index > C_CAPACITY) return nullptr;
+		Timer* t = &timers[index - 1];
+		return (t->fn && t->generation == (id >> 16)) ? t : nullptr;
+	}
+
+	// Pick the finest level whose span still covers the delay
+	void Link(Timer* t) {
+		uint64_t delta = t->due - now;
+		int level = 0;
+		while (level < C_LEVELS - 1 && delta >= (1ull << ((level + 1) * C_BITS))) {
+			level++;
+		}
+		size_t slot = level * C_SLOTS + ((t->due >> (level * C_BITS)) & C_MASK);
+		t->slot = static_cast<uint16_t>(slot);
+		t->prev = nullptr;
+		t->next = slots[slot];
+		if (t->next) t->next->prev = t;
+		slots[slot] = t;
+	}
+
+	void Unlink(Timer* t) {
+		if (t->prev) t->prev->next = t->next;
+		else slots[t->slot] = t->next;
+		if (t->next) t->next->prev = t->prev;
+	}
+
+	void Release(Timer* t) {
+		t->fn = nullptr;
+		t->generation++;
+		t->next = freeList;
+		freeList = t;
+		active--;
+	}
+
+	void Tick() {
+		now++;
+		size_t index = now & C_MASK;
+		// A finer wheel wrapped around, bring the next slot of the coarser one down
+		for (int level = 1; level < C_LEVELS && index == 0; ++level) {
+			index = (now >> (level * C_BITS)) & C_MASK;
+			Timer*& head = slots[level * C_SLOTS + index];
+			while (head) {
+				Timer* t = head;
+				Unlink(t);
+				Link(t);
+			}
+		}
+		// Re-armed and newly scheduled timers are at least one tick out, never land in this slot again
+		Timer*& due = slots[now & C_MASK];
+		while (due) {
+			Timer* t = due;
+			Unlink(t);
+			TimerFn fn = t->fn;
+			void* ctx = t->ctx;
+			uintptr_t arg = t->arg;
+			if (t->remaining == 1) {
+				Release(t);
+			}
+			else {
+				if (t->remaining > 0) t->remaining--;
+				t->due += t->interval;
+				Link(t);
+			}
+			fn(ctx, arg);
+		}
+	}
+
+	static constexpr int C_BITS = 6;
+	static constexpr size_t C_SLOTS = 1 << C_BITS;
+	static constexpr uint64_t C_MASK = C_SLOTS - 1;
+	static constexpr int C_LEVELS = 4;
+	static constexpr uint32_t C_MAX_TICKS = (1u << (C_LEVELS * C_BITS)) - 1;
+	static constexpr float C_TICKS_PER_SECOND = 128.f;
+	static constexpr size_t C_CAPACITY = 2048;
+
+	Timer timers[C_CAPACITY]{};
+	Timer* slots[C_LEVELS * C_SLOTS]{};
+	Timer* freeList = nullptr;
+	uint64_t now = 0;
+	double pending = 0.0;
+	int active = 0;
+};
+
+// --- TRANSFORM, PHYSICS, LIFETIME, RENDERABLE ---
+struct TransformA {
+	Vector2 position{};
+	float rotation{};
+};
+
+struct Physics {
+	Vector2 velocity{};
+	float rotationSpeed{};
+};
+
+struct Renderable {
+	enum Size { SMALL = 1, MEDIUM = 2, LARGE = 4 } size = SMALL;
+};
+
+// --- COLLISION ---
+// Convex polygons as vertex lists in either winding
+namespace Collision {
+	inline bool CircleVsPolygon(Vector2 c, float r, const Vector2* pts, int n) {
+		bool pos = false;
+		bool neg = false;
+		for (int i = 0; i < n; ++i) {
+			Vector2 edge = Vector2Subtract(pts[(i + 1) % n], pts[i]);
+			Vector2 rel = Vector2Subtract(c, pts[i]);
+			float cross = edge.x * rel.y - edge.y * rel.x;
+			pos |= cross > 0.f;
+			neg |= cross < 0.f;
+			// Closest point of the edge to the center
+			float t = Clamp(Vector2DotProduct(rel, edge) / Vector2DotProduct(edge, edge), 0.f, 1.f);
+			if (Vector2LengthSqr(Vector2Subtract(rel, Vector2Scale(edge, t))) <= r * r) return true;
+		}
+		// Center on the same side of every edge
+		return !(pos && neg);
+	}
+
+	// Separating axis test, the edge normals of both polygons are the candidate axes
+	inline bool PolygonVsPolygon(const Vector2* a, int na, const Vector2* b, int nb) {
+		auto separated = [](const Vector2* p, int np, const Vector2* q, int nq) {
+			for (int i = 0; i < np; ++i) {
+				Vector2 edge = Vector2Subtract(p[(i + 1) % np], p[i]);
+				Vector2 axis = { -edge.y, edge.x };
+				float minP = INFINITY, maxP = -INFINITY, minQ = INFINITY, maxQ = -INFINITY;
+				for (int j = 0; j < np; ++j) {
+					float d = Vector2DotProduct(p[j], axis);
+					minP = fminf(minP, d);
+					maxP = fmaxf(maxP, d);
+				}
+				for (int j = 0; j < nq; ++j) {
+					float d = Vector2DotProduct(q[j], axis);
+					minQ = fminf(minQ, d);
+					maxQ = fmaxf(maxQ, d);
+				}
+				if (maxP < minQ || maxQ < minP) return true;
+			}
+			return false;
+		};
+		return !separated(a, na, b, nb) && !separated(b, nb, a, na);
+	}
+}
+
+// --- CAPTURE ---
+// Single producer, single consumer queue, lock-free on both ends
+template <typename T, size_t N>
+class SpscQueue {
+public:
+	bool Push(const T& v) {
+		uint32_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == N) return false;
+		items[t % N] = v;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool Pop(T& v) {
+		uint32_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)) return false;
+		v = items[h % N];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	void Clear() {
+		head.store(0);
+		tail.store(0);
+	}
+
+private:
+	std::atomic<uint32_t> head{ 0 };
+	std::atomic<uint32_t> tail{ 0 };
+	T items[N]{};
+};
+
+// Gameplay recording. Frames are copied into a ring of pixel buffers on the GPU and mapped a
+// few frames later, once the copy is done, then encoded on a worker thread. When the GPU or the
+// encoder falls behind the frame is dropped, the game never waits for either.
+class FrameRecorder {
+public:
+	enum class Format { QOI, GIF };
+
+	static FrameRecorder& Instance() {
+		static FrameRecorder inst;
+		return inst;
+	}
+
+	bool Start(int w, int h, Format fmt, const char* prefix) {
+		if (recording) return false;
+		width = w;
+		height = h;
+		format = fmt;
+		frameBytes = static_cast<size_t>(w) * h * 4;
+		session++;
+		snprintf(name, sizeof(name), "%s_%d", prefix, session);
+		for (Readback& rb : readbacks) {
+			rb.id = rlLoadPixelBuffer(static_cast<int>(frameBytes));
+			rb.fence = nullptr;
+		}
+		if (readbacks[0].id == 0) {
+			TraceLog(LOG_WARNING, "RECORD: Pixel buffers not supported, recording disabled");
+			return false;
+		}
+		if (format == Format::GIF) {
+			gifFile = fopen(TextFormat("%s.gif", name), "wb");
+			if (!gifFile || !msf_gif_begin_to_file(&gif, w, h, WriteGif, gifFile)) {
+				TraceLog(LOG_WARNING, "RECORD: Failed to open %s.gif", name);
+				if (gifFile) fclose(gifFile);
+				gifFile = nullptr;
+				for (Readback& rb : readbacks) rlUnloadPixelBuffer(rb.id);
+				return false;
+			}
+		}
+		freeSlots.Clear();
+		filled.Clear();
+		for (int i = 0; i < static_cast<int>(C_QUEUE_FRAMES); ++i) {
+			frames[i].resize(frameBytes);
+			freeSlots.Push(i);
+		}
+		next = 0;
+		frameCounter = 0;
+		captured = 0;
+		dropped = 0;
+		encoded = 0;
+		lastEncoded = 0;
+		stopping = false;
+		worker = std::thread(&FrameRecorder::EncodeLoop, this);
+		recording = true;
+		TraceLog(LOG_INFO, "RECORD: Recording %s to %s%s", format == Format::GIF ? "GIF" : "QOI frames", name,
+			format == Format::GIF ? ".gif" : "_*.qoi");
+		return true;
+	}
+
+	// Queued frames are still encoded, readbacks in flight on the GPU are discarded
+	void Stop() {
+		if (!recording) return;
+		for (Readback& rb : readbacks) {
+			rlUnloadSync(rb.fence);
+			rlUnloadPixelBuffer(rb.id);
+		}
+		stopping = true;
+		signal.fetch_add(1, std::memory_order_release);
+		signal.notify_one();
+		worker.join();
+		if (gifFile) {
+			msf_gif_end_to_file(&gif);
+			fclose(gifFile);
+			gifFile = nullptr;
+		}
+		for (std::vector<unsigned char>& f : frames) {
+			std::vector<unsigned char>().swap(f);
+		}
+		recording = false;
+		TraceLog(LOG_INFO, "RECORD: %s done, %d frames captured, %d dropped, %d encoded", name, captured, dropped,
+			encoded.load());
+	}
+
+	bool IsRecording() const {
+		return recording;
+	}
+
+	int Captured() const {
+		return captured;
+	}
+
+	int Dropped() const {
+		return dropped;
+	}
+
+	// Main thread, once per frame with everything drawn and flushed
+	void Grab() {
+		Readback& rb = readbacks[next];
+		if (rb.fence) {
+			Collect(rb);
+		}
+		rb.fence = rlReadScreenPixelsAsync(rb.id, width, height);
+		rb.frame = frameCounter++;
+		next = (next + 1) % C_READBACKS;
+	}
+
+private:
+	struct Readback {
+		unsigned int id = 0;
+		void* fence = nullptr;
+		int frame = 0;
+	};
+
+	FrameRecorder() = default;
+
+	void Collect(Readback& rb) {
+		bool ready = rlIsSyncSignaled(rb.fence);
+		rlUnloadSync(rb.fence);
+		rb.fence = nullptr;
+		if (!ready) {
+			dropped++;
+			return;
+		}
+		// Map before taking a slot: only the encoder pushes free slots, a failed map has nothing to return
+		const unsigned char* src = rlMapPixelBuffer(rb.id, static_cast<int>(frameBytes));
+		if (!src) {
+			dropped++;
+			return;
+		}
+		int slot = 0;
+		if (!freeSlots.Pop(slot)) {
+			rlUnmapPixelBuffer();
+			dropped++;
+			return;
+		}
+		// Rows come bottom-up, flip while copying out
+		size_t stride = static_cast<size_t>(width) * 4;
+		unsigned char* dst = frames[slot].data();
+		for (int y = 0; y < height; ++y) {
+			memcpy(dst + (height - 1 - y) * stride, src + y * stride, stride);
+		}
+		rlUnmapPixelBuffer();
+		frameIds[slot] = rb.frame;
+		filled.Push(slot);
+		captured++;
+		signal.fetch_add(1, std::memory_order_release);
+		signal.notify_one();
+	}
+
+	// Worker thread
+	void EncodeLoop() {
+		for (;;) {
+			uint32_t seen = signal.load(std::memory_order_acquire);
+			int slot = 0;
+			while (filled.Pop(slot)) {
+				Encode(slot);
+				freeSlots.Push(slot);
+			}
+			if (stopping) break;
+			signal.wait(seen, std::memory_order_acquire);
+		}
+	}
+
+	void Encode(int slot) {
+		unsigned char* px = frames[slot].data();
+		// The framebuffer alpha is not meaningful
+		for (size_t i = 3; i < frameBytes; i += 4) {
+			px[i] = 255;
+		}
+		int id = frameIds[slot];
+		if (format == Format::QOI) {
+			char path[300];
+			snprintf(path, sizeof(path), "%s_%05d.qoi", name, id);
+			qoi_desc desc = { static_cast<unsigned int>(width), static_cast<unsigned int>(height), 4, QOI_SRGB };
+			qoi_write(path, px, &desc);
+		}
+		else {
+			// Delays follow frame numbers so dropped frames keep the clip in real time
+			int cs = (id * 100 + C_RECORD_FPS / 2) / C_RECORD_FPS - (lastEncoded * 100 + C_RECORD_FPS / 2) / C_RECORD_FPS;
+			msf_gif_frame_to_file(&gif, px, std::max(cs, 1), 16, width * 4);
+		}
+		lastEncoded = id;
+		encoded++;
+	}
+
+	static size_t WriteGif(const void* buffer, size_t size, size_t count, void* stream) {
+		return fwrite(buffer, size, count, static_cast<FILE*>(stream));
+	}
+
+	static constexpr int C_READBACKS = 3;
+	static constexpr size_t C_QUEUE_FRAMES = 8;
+	static constexpr int C_RECORD_FPS = 60;
+
+	Readback readbacks[C_READBACKS];
+	std::vector<unsigned char> frames[C_QUEUE_FRAMES];
+	int frameIds[C_QUEUE_FRAMES]{};
+	SpscQueue<int, C_QUEUE_FRAMES> freeSlots;
+	SpscQueue<int, C_QUEUE_FRAMES> filled;
+	std::atomic<uint32_t> signal{ 0 };
+	std::atomic<bool> stopping{ false };
+	std::atomic<int> encoded{ 0 };
+	std::thread worker;
+
+	Format format = Format::GIF;
+	MsfGifState gif{};
+	FILE* gifFile = nullptr;
+	char name[256]{};
+	int session = 0;
+	int width = 0;
+	int height = 0;
+	size_t frameBytes = 0;
+	int next = 0;
+	int frameCounter = 0;
+	int captured = 0;
+	int dropped = 0;
+	int lastEncoded = 0;
+	bool recording = false;
+};
+
+// --- RENDERER ---
+class Renderer {
+public:
+	static Renderer& Instance() {
+		static Renderer inst;
+		return inst;
+	}
+
+	void Init(int w, int h, const char* title) {
+		InitWindow(w, h, title);
+		LimitFps(60);
+		screenW = w;
+		screenH = h;
+		camera.offset = { w * 0.5f, h * 0.5f };
+		camera.target = camera.offset;
+		camera.zoom = 1.f;
+		commands.reserve(C_MAX_COMMANDS);
+		order.reserve(C_MAX_COMMANDS);
+		// Same 36 segment outline DrawCircleV() computes per call
+		for (int i = 0; i <= C_CIRCLE_SEGMENTS; ++i) {
+			float a = 2.f * PI * i / C_CIRCLE_SEGMENTS;
+			unitCircle[i] = { cosf(a), sinf(a) };
+		}
+	}
+
+	void Begin() {
+		beginTime = GetTime();
+		BeginDrawing();
+		ClearBackground(BLACK);
+		BeginMode2D(camera);
+		inWorld = true;
+	}
+
+	// Center the view on target, kept inside bounds
+	void Follow(Vector2 target, const Rectangle& bounds) {
+		camera.target = {
+			Clamp(target.x, bounds.x + camera.offset.x, bounds.x + bounds.width - camera.offset.x),
+			Clamp(target.y, bounds.y + camera.offset.y, bounds.y + bounds.height - camera.offset.y)
+		};
+	}
+
+	// Visible part of the world
+	Rectangle View() const {
+		return { camera.target.x - camera.offset.x, camera.target.y - camera.offset.y,
+			static_cast<float>(screenW), static_cast<float>(screenH) };
+	}
+
+	// Emit the world and switch to screen space for the HUD
+	void EndWorld() {
+		Flush();
+		if (inWorld) {
+			EndMode2D();
+			inWorld = false;
+		}
+	}
+
+	void End() {
+		EndWorld();
+		if (FrameRecorder::Instance().IsRecording()) {
+			AllocTracker::Instance().BeginDriver();
+			rlDrawRenderBatchActive();
+			FrameRecorder::Instance().Grab();
+			AllocTracker::Instance().EndDriver();
+		}
+		double endTime = GetTime();
+		AllocTracker::Instance().BeginDriver();
+		EndDrawing();
+		AllocTracker::Instance().EndDriver();
+		double swapTime = GetTime();
+		recordSeconds = endTime - beginTime;
+		submitSeconds = swapTime - endTime;
+		// The limiter waits here instead of inside EndDrawing(), so the wait is not mistaken for work
+		limiterSeconds = 0.0;
+		if (targetFrameTime > 0.0 && swapTime - frameEndTime < targetFrameTime) {
+			WaitTime(targetFrameTime - (swapTime - frameEndTime));
+			limiterSeconds = GetTime() - swapTime;
+		}
+		frameEndTime = GetTime();
+		// EndDrawing() flushed the last batch, the whole frame is counted now
+		frameStats = rlGetRenderStats();
+		rlResetRenderStats();
+		frameIndex++;
+		if (statsFile) {
+			WriteStats();
+		}
+	}
+
+	// Commands are buffered until Flush(). Layers are emitted in order, inside a layer
+	// commands are grouped by primitive and texture and keep submission order within a group.
+	// Painter's order, sorting never moves a command across layers
+	enum class Layer : uint8_t { PROJECTILES, ASTEROIDS, PICKUPS, SHIP };
+
+	void SubmitCircle(Layer layer, Vector2 center, float radius, Color color) {
+		DrawCommand& c = Push(layer, DrawCommand::CIRCLE, RL_QUADS, rlGetTextureIdDefault());
+		c.color = color;
+		c.circle = { center, radius };
+	}
+
+	void SubmitRect(Layer layer, const Rectangle& rec, Color color) {
+		DrawCommand& c = Push(layer, DrawCommand::RECT, RL_QUADS, rlGetTextureIdDefault());
+		c.color = color;
+		c.rect = rec;
+	}
+
+	// Closed outline, pts must stay valid until the buffer is flushed
+	void SubmitOutline(Layer layer, const Vector2* pts, int count, Color color) {
+		DrawCommand& c = Push(layer, DrawCommand::OUTLINE, RL_LINES, rlGetTextureIdDefault());
+		c.color = color;
+		c.outline = { pts, count };
+	}
+
+	void SubmitTexture(Layer layer, const Texture2D& tex, Vector2 pos, float scale, Color tint) {
+		DrawCommand& c = Push(layer, DrawCommand::TEXTURE, RL_QUADS, tex.id);
+		c.color = tint;
+		c.texture = { tex, pos, scale };
+	}
+
+	// Emit everything buffered so far, immediate raylib drawing after this lands on top
+	void Flush() {
+		if (commands.empty()) return;
+		if (sorting) {
+			std::sort(order.begin(), order.end());
+		}
+		int mode = -1;
+		unsigned int texture = 0;
+		for (uint64_t key : order) {
+			const DrawCommand& c = commands[key & 0xFFFFFFFF];
+			if (c.kind == DrawCommand::TEXTURE) {
+				if (mode >= 0) rlEnd();
+				mode = -1;
+				DrawTextureEx(c.texture.tex, c.texture.pos, 0.f, c.texture.scale, c.color);
+				continue;
+			}
+			if (c.mode != mode || c.textureId != texture) {
+				if (mode >= 0) rlEnd();
+				mode = c.mode;
+				texture = c.textureId;
+				rlSetTexture(texture);
+				rlBegin(mode);
+			}
+			rlColor4ub(c.color.r, c.color.g, c.color.b, c.color.a);
+			Emit(c);
+		}
+		if (mode >= 0) rlEnd();
+		rlSetTexture(0);
+		commands.clear();
+		order.clear();
+	}
+
+	// Off emits in submission order, for comparing draw call counts
+	void SetSorting(bool enabled) {
+		sorting = enabled;
+	}
+
+	int Width() const {
+		return screenW;
+	}
+
+	int Height() const {
+		return screenH;
+	}
+
+	// rlgl batch statistics of the last finished frame
+	const rlRenderStats& Stats() const {
+		return frameStats;
+	}
+
+	// CPU time of the last frame spent issuing draws (Begin to End) and in EndDrawing()
+	double RecordSeconds() const {
+		return recordSeconds;
+	}
+
+	double SubmitSeconds() const {
+		return submitSeconds;
+	}
+
+	// Time the last frame slept to hold the target frame rate
+	double LimiterSeconds() const {
+		return limiterSeconds;
+	}
+
+	// Frame rate cap, 0 runs unlimited. Replaces SetTargetFPS(), raylib's own limiter stays off.
+	void LimitFps(int fps) {
+		SetTargetFPS(0);
+		targetFrameTime = (fps > 0) ? 1.0 / fps : 0.0;
+	}
+
+	// Write what has been drawn so far this frame to an image file
+	void Capture(const char* path) {
+		double start = GetTime();
+		Flush();
+		// Dumping is a debug aid that allocates the image on purpose
+		AllocTracker::Instance().BeginExternal();
+		rlDrawRenderBatchActive();
+		Image img = LoadImageFromScreen();
+		ExportImage(img, path);
+		UnloadImage(img);
+		AllocTracker::Instance().EndExternal();
+		// Keep the readback out of the frame's record time
+		beginTime += GetTime() - start;
+	}
+
+	bool StartStatsDump(const char* path) {
+		StopStatsDump();
+		statsFile = fopen(path, "w");
+		if (!statsFile) {
+			TraceLog(LOG_WARNING, "RENDER: Failed to open stats file %s", path);
+			return false;
+		}
+		// Own buffer so writing does not allocate later in the frame
+		setvbuf(statsFile, statsBuffer, _IOFBF, sizeof(statsBuffer));
+		fprintf(statsFile, "frame,draw_calls,vertices,flushes,flush_explicit,flush_mode,flush_texture,flush_buffer,"
+			"mode_breaks,texture_breaks,uploads,upload_bytes\n");
+		TraceLog(LOG_INFO, "RENDER: Dumping stats to %s", path);
+		return true;
+	}
+
+	void StopStatsDump() {
+		if (statsFile) {
+			fclose(statsFile);
+			statsFile = nullptr;
+		}
+	}
+
+	bool IsDumpingStats() const {
+		return statsFile != nullptr;
+	}
+
+	void DrawStats(int x, int y) const {
+		const rlRenderStats& st = frameStats;
+		// Anything but the end of frame flush means the batch got broken up
+		int forced = st.flushes - st.flushReasons[RL_FLUSH_EXPLICIT];
+		DrawText(TextFormat("Draw calls: %d  Vertices: %d", st.drawCalls, st.vertices), x, y, 20, YELLOW);
+		DrawText(TextFormat("Flushes: %d (mode %d, texture %d, buffer full %d)", st.flushes,
+			st.flushReasons[RL_FLUSH_MODE_CHANGE], st.flushReasons[RL_FLUSH_TEXTURE_CHANGE],
+			st.flushReasons[RL_FLUSH_BUFFER_FULL]), x, y + 20, 20, forced > 0 ? RED : YELLOW);
+		DrawText(TextFormat("Breaks: mode %d, texture %d", st.modeBreaks, st.textureBreaks), x, y + 40, 20, YELLOW);
+		DrawText(TextFormat("Uploads: %d (%d KB)%s", st.bufferUploads, st.uploadBytes / 1024,
+			statsFile ? "  [dumping]" : ""), x, y + 60, 20, YELLOW);
+	}
+
+private:
+	struct DrawCommand {
+		enum Kind : uint8_t { CIRCLE, RECT, OUTLINE, TEXTURE } kind;
+		uint8_t mode;
+		unsigned int textureId;
+		Color color;
+		union {
+			struct { Vector2 center; float radius; } circle;
+			Rectangle rect;
+			struct { const Vector2* pts; int count; } outline;
+			struct { Texture2D tex; Vector2 pos; float scale; } texture;
+		};
+	};
+
+	Renderer() = default;
+
+	DrawCommand& Push(Layer layer, DrawCommand::Kind kind, int mode, unsigned int textureId) {
+		// Full buffer: emit early rather than grow, ordering is still kept
+		if (commands.size() == C_MAX_COMMANDS) {
+			Flush();
+		}
+		uint64_t index = commands.size();
+		// Layer, then primitive mode, then texture; the index keeps the sort stable
+		order.push_back((static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(mode & 0xFF) << 48) |
+			(static_cast<uint64_t>(textureId & 0xFFFF) << 32) | index);
+		commands.emplace_back();
+		DrawCommand& c = commands.back();
+		c.kind = kind;
+		c.mode = static_cast<uint8_t>(mode);
+		c.textureId = textureId;
+		return c;
+	}
+
+	// Vertices only, the caller has opened the matching rlBegin() group
+	void Emit(const DrawCommand& c) {
+		switch (c.kind) {
+		case DrawCommand::CIRCLE: {
+			// Each quad covers two segments, like DrawCircleSector() in quads mode
+			Vector2 o = c.circle.center;
+			float r = c.circle.radius;
+			for (int i = 0; i < C_CIRCLE_SEGMENTS; i += 2) {
+				rlTexCoord2f(0.f, 0.f);
+				rlVertex2f(o.x, o.y);
+				rlVertex2f(o.x + unitCircle[i + 2].x * r, o.y + unitCircle[i + 2].y * r);
+				rlVertex2f(o.x + unitCircle[i + 1].x * r, o.y + unitCircle[i + 1].y * r);
+				rlVertex2f(o.x + unitCircle[i].x * r, o.y + unitCircle[i].y * r);
+			}
+			break;
+		}
+		case DrawCommand::RECT: {
+			const Rectangle& r = c.rect;
+			rlTexCoord2f(0.f, 0.f);
+			rlVertex2f(r.x, r.y);
+			rlVertex2f(r.x, r.y + r.height);
+			rlVertex2f(r.x + r.width, r.y + r.height);
+			rlVertex2f(r.x + r.width, r.y);
+			break;
+		}
+		case DrawCommand::OUTLINE: {
+			const Vector2* pts = c.outline.pts;
+			int n = c.outline.count;
+			for (int i = 0; i < n; ++i) {
+				const Vector2& b = pts[(i + 1) % n];
+				rlVertex2f(pts[i].x, pts[i].y);
+				rlVertex2f(b.x, b.y);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void WriteStats() {
+		const rlRenderStats& st = frameStats;
+		fprintf(statsFile, "%llu,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\n", static_cast<unsigned long long>(frameIndex),
+			st.drawCalls, st.vertices, st.flushes,
+			st.flushReasons[RL_FLUSH_EXPLICIT], st.flushReasons[RL_FLUSH_MODE_CHANGE],
+			st.flushReasons[RL_FLUSH_TEXTURE_CHANGE], st.flushReasons[RL_FLUSH_BUFFER_FULL],
+			st.modeBreaks, st.textureBreaks, st.bufferUploads, st.uploadBytes);
+	}
+
+	int screenW{};
+	int screenH{};
+
+	rlRenderStats frameStats{};
+	uint64_t frameIndex = 0;
+	double beginTime = 0.0;
+	double recordSeconds = 0.0;
+	double submitSeconds = 0.0;
+	double limiterSeconds = 0.0;
+	double targetFrameTime = 0.0;
+	double frameEndTime = 0.0;
+	FILE* statsFile = nullptr;
+	char statsBuffer[1 << 16];
+
+	Camera2D camera{};
+	bool inWorld = false;
+
+	static constexpr size_t C_MAX_COMMANDS = 32768;
+	static constexpr int C_CIRCLE_SEGMENTS = 36;
+	std::vector<DrawCommand> commands;
+	std::vector<uint64_t> order;
+	Vector2 unitCircle[C_CIRCLE_SEGMENTS + 1];
+	bool sorting = true;
 };
 
-struct Physics {
-	Vector2 velocity{};
-	float rotationSpeed{};
+// --- AUDIO ---
+enum class Sfx { LASER = 0, BULLET, ENEMY_LASER, ENEMY_BULLET, EXPLOSION_SMALL, EXPLOSION_MEDIUM, EXPLOSION_LARGE, PLAYER_HIT, PICKUP, COUNT };
+enum class SfxCategory { PLAYER_WEAPON = 0, ENEMY_WEAPON = 1, EXPLOSION = 2, EVENT = 3, COUNT = 4 };
+
+struct SfxInfo {
+	const char* file;      // optional override, loaded instead of the synthesized sound
+	SfxCategory category;
+	int priority;          // higher steals lower when the pool is full
+	float gain;
 };
 
-struct Renderable {
-	enum Size { SMALL = 1, MEDIUM = 2, LARGE = 4 } size = SMALL;
+static constexpr SfxInfo SFX_INFO[static_cast<int>(Sfx::COUNT)] = {
+	{ "sfx/laser.wav",            SfxCategory::PLAYER_WEAPON, 1, 0.25f },
+	{ "sfx/bullet.wav",           SfxCategory::PLAYER_WEAPON, 1, 0.25f },
+	{ "sfx/enemy_laser.wav",      SfxCategory::ENEMY_WEAPON,  0, 0.20f },
+	{ "sfx/enemy_bullet.wav",     SfxCategory::ENEMY_WEAPON,  0, 0.20f },
+	{ "sfx/explosion_small.wav",  SfxCategory::EXPLOSION,     2, 0.45f },
+	{ "sfx/explosion_medium.wav", SfxCategory::EXPLOSION,     2, 0.55f },
+	{ "sfx/explosion_large.wav",  SfxCategory::EXPLOSION,     3, 0.65f },
+	{ "sfx/player_hit.wav",       SfxCategory::EVENT,         4, 0.60f },
+	{ "sfx/pickup.wav",           SfxCategory::EVENT,         4, 0.50f },
 };
 
-// --- RENDERER ---
-class Renderer {
+// Pre-decoded mono float PCM, every sound packed into one buffer at startup
+class SoundBank {
 public:
-	static Renderer& Instance() {
-		static Renderer inst;
-		return inst;
+	void Load(int sampleRate) {
+		rate = sampleRate;
+		pcm.clear();
+		for (int i = 0; i < static_cast<int>(Sfx::COUNT); ++i) {
+			offsets[i] = static_cast<int>(pcm.size());
+			if (!LoadFile(SFX_INFO[i].file)) {
+				Synthesize(static_cast<Sfx>(i));
+			}
+			frames[i] = static_cast<int>(pcm.size()) - offsets[i];
+		}
 	}
 
-	void Init(int w, int h, const char* title) {
-		InitWindow(w, h, title);
-		SetTargetFPS(60);
-		screenW = w;
-		screenH = h;
+	const float* Samples(Sfx id) const {
+		return pcm.data() + offsets[static_cast<int>(id)];
 	}
 
-	void Begin() {
-		BeginDrawing();
-		ClearBackground(BLACK);
+	int Frames(Sfx id) const {
+		return frames[static_cast<int>(id)];
 	}
 
-	void End() {
-		EndDrawing();
+private:
+	bool LoadFile(const char* path) {
+		if (!FileExists(path)) return false;
+		Wave wave = LoadWave(path);
+		if (!IsWaveReady(wave)) return false;
+		WaveFormat(&wave, rate, 32, 1);
+		float* samples = LoadWaveSamples(wave);
+		pcm.insert(pcm.end(), samples, samples + wave.frameCount);
+		UnloadWaveSamples(samples);
+		UnloadWave(wave);
+		return true;
 	}
 
-	void DrawPoly(const Vector2& pos, int sides, float radius, float rot) {
-		DrawPolyLines(pos, sides, radius, rot, WHITE);
+	// Cheap deterministic noise, keeps rand() untouched for gameplay
+	float Noise() {
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * 2.f - 1.f;
 	}
 
-	int Width() const {
-		return screenW;
+	void Tone(float seconds, float f0, float f1, float square, float noise, float decay) {
+		int n = static_cast<int>(seconds * rate);
+		float phase = 0.f;
+		float lp = 0.f;
+		for (int s = 0; s < n; ++s) {
+			float t = static_cast<float>(s) / n;
+			float f = f0 + (f1 - f0) * t;
+			phase += f / rate;
+			phase -= floorf(phase);
+			float tone = (phase < 0.5f) ? 1.f : -1.f;
+			tone = tone * square + sinf(2.f * PI * phase) * (1.f - square);
+			lp += (Noise() - lp) * 0.2f;
+			float env = expf(-decay * t) * fminf(1.f, s / (0.002f * rate));
+			pcm.push_back((tone * (1.f - noise) + lp * noise) * env);
+		}
 	}
 
-	int Height() const {
-		return screenH;
+	void Synthesize(Sfx id) {
+		switch (id) {
+		case Sfx::LASER:            Tone(0.08f, 1800.f, 600.f, 1.f, 0.f, 4.f); break;
+		case Sfx::BULLET:           Tone(0.05f, 900.f, 300.f, 0.5f, 0.5f, 6.f); break;
+		case Sfx::ENEMY_LASER:      Tone(0.10f, 900.f, 300.f, 1.f, 0.f, 4.f); break;
+		case Sfx::ENEMY_BULLET:     Tone(0.06f, 500.f, 200.f, 0.5f, 0.5f, 6.f); break;
+		case Sfx::EXPLOSION_SMALL:  Tone(0.30f, 120.f, 40.f, 0.f, 0.9f, 5.f); break;
+		case Sfx::EXPLOSION_MEDIUM: Tone(0.50f, 90.f, 30.f, 0.f, 0.9f, 5.f); break;
+		case Sfx::EXPLOSION_LARGE:  Tone(0.80f, 70.f, 25.f, 0.f, 0.9f, 4.f); break;
+		case Sfx::PLAYER_HIT:       Tone(0.15f, 220.f, 110.f, 1.f, 0.3f, 3.f); break;
+		case Sfx::PICKUP:           Tone(0.20f, 600.f, 1400.f, 0.f, 0.f, 2.f); break;
+		default: break;
+		}
+	}
+
+	std::vector<float> pcm;
+	int offsets[static_cast<int>(Sfx::COUNT)]{};
+	int frames[static_cast<int>(Sfx::COUNT)]{};
+	int rate = 0;
+	uint32_t seed = 0x1234567u;
+};
+
+// Fixed voice pool mixed on the audio thread. The game thread only appends
+// events to a per-tick batch and publishes it with one atomic store in Flush().
+class AudioEngine {
+public:
+	static AudioEngine& Instance() {
+		static AudioEngine inst;
+		return inst;
+	}
+
+	void Init() {
+		InitAudioDevice();
+		if (!IsAudioDeviceReady()) return;
+		bank.Load(C_SAMPLE_RATE);
+		SetAudioStreamBufferSizeDefault(C_STREAM_FRAMES);
+		stream = LoadAudioStream(C_SAMPLE_RATE, 32, 2);
+		SetAudioStreamCallback(stream, MixCallback);
+		PlayAudioStream(stream);
+		ready = true;
+	}
+
+	void Shutdown() {
+		if (!ready) return;
+		ready = false;
+		UnloadAudioStream(stream);
+		CloseAudioDevice();
+	}
+
+	// Game thread: queue a sound for this tick at world x, events of the same kind are coalesced
+	void Post(Sfx id, float x, float gain = 1.f) {
+		if (!ready) return;
+		int& slot = pendingSlot[static_cast<int>(id)];
+		Rectangle view = Renderer::Instance().View();
+		float pan = Clamp((x - view.x) / view.width * 2.f - 1.f, -1.f, 1.f);
+		if (slot >= 0) {
+			SfxEvent& ev = pending.events[slot];
+			ev.count++;
+			ev.pan += (pan - ev.pan) / ev.count;
+			ev.gain = fmaxf(ev.gain, gain);
+			return;
+		}
+		slot = pending.count;
+		pending.events[pending.count++] = { id, gain, pan, 1 };
+	}
+
+	// Game thread: publish the tick batch, dropped if the audio thread fell behind
+	void Flush() {
+		if (!ready || pending.count == 0) return;
+		uint32_t h = head.load(std::memory_order_relaxed);
+		if (h - tail.load(std::memory_order_acquire) < C_RING_BATCHES) {
+			ring[h % C_RING_BATCHES] = pending;
+			head.store(h + 1, std::memory_order_release);
+		}
+		pending.count = 0;
+		for (int& slot : pendingSlot) slot = -1;
+	}
+
+	int ActiveVoices() const {
+		return activeVoices.load(std::memory_order_relaxed);
 	}
 
 private:
-	Renderer() = default;
+	struct SfxEvent {
+		Sfx id;
+		float gain;
+		float pan;   // -1 left .. 1 right
+		int count;   // events coalesced into this one
+	};
 
-	int screenW{};
-	int screenH{};
+	// One event per sound kind at most, thanks to coalescing
+	struct Batch {
+		SfxEvent events[static_cast<int>(Sfx::COUNT)];
+		int count = 0;
+	};
+
+	struct Voice {
+		const float* data = nullptr;
+		int frames = 0;
+		int cursor = 0;
+		float gainL = 0.f;
+		float gainR = 0.f;
+		SfxCategory category = SfxCategory::EVENT;
+		int priority = 0;
+		bool active = false;
+	};
+
+	AudioEngine() {
+		for (int& slot : pendingSlot) slot = -1;
+	}
+
+	static void MixCallback(void* buffer, unsigned int frameCount) {
+		Instance().Mix(static_cast<float*>(buffer), frameCount);
+	}
+
+	// Audio thread
+	void Mix(float* out, unsigned int frameCount) {
+		uint32_t t = tail.load(std::memory_order_relaxed);
+		uint32_t h = head.load(std::memory_order_acquire);
+		for (; t != h; ++t) {
+			const Batch& b = ring[t % C_RING_BATCHES];
+			for (int i = 0; i < b.count; ++i) {
+				Start(b.events[i]);
+			}
+		}
+		tail.store(t, std::memory_order_release);
+
+		memset(out, 0, sizeof(float) * 2 * frameCount);
+		int active = 0;
+		for (Voice& v : voices) {
+			if (!v.active) continue;
+			int n = std::min(static_cast<int>(frameCount), v.frames - v.cursor);
+			const float* src = v.data + v.cursor;
+			for (int i = 0; i < n; ++i) {
+				out[2 * i] += src[i] * v.gainL;
+				out[2 * i + 1] += src[i] * v.gainR;
+			}
+			v.cursor += n;
+			if (v.cursor >= v.frames) {
+				Release(v);
+			}
+			else {
+				active++;
+			}
+		}
+		for (unsigned int i = 0; i < 2 * frameCount; ++i) {
+			out[i] = out[i] / (1.f + fabsf(out[i]));
+		}
+		activeVoices.store(active, std::memory_order_relaxed);
+	}
+
+	void Start(const SfxEvent& ev) {
+		const SfxInfo& info = SFX_INFO[static_cast<int>(ev.id)];
+		Voice* v = PickVoice(info.category, info.priority);
+		if (!v) return;
+		if (v->active) Release(*v);
+
+		// Several shots in one tick play as one louder voice
+		float gain = info.gain * ev.gain * (1.f + 0.15f * (std::min(ev.count, 8) - 1));
+		float a = (ev.pan + 1.f) * PI * 0.25f;
+		v->data = bank.Samples(ev.id);
+		v->frames = bank.Frames(ev.id);
+		v->cursor = 0;
+		v->gainL = cosf(a) * gain;
+		v->gainR = sinf(a) * gain;
+		v->category = info.category;
+		v->priority = info.priority;
+		v->active = true;
+		categoryVoices[static_cast<int>(info.category)]++;
+	}
+
+	void Release(Voice& v) {
+		v.active = false;
+		categoryVoices[static_cast<int>(v.category)]--;
+	}
+
+	Voice* PickVoice(SfxCategory category, int priority) {
+		// Category at its limit: recycle its most played voice
+		if (categoryVoices[static_cast<int>(category)] >= C_CATEGORY_LIMIT[static_cast<int>(category)]) {
+			Voice* oldest = nullptr;
+			for (Voice& v : voices) {
+				if (v.active && v.category == category && (!oldest || v.cursor > oldest->cursor)) oldest = &v;
+			}
+			return oldest;
+		}
+		for (Voice& v : voices) {
+			if (!v.active) return &v;
+		}
+		// Pool full: steal the least important voice, the most played one first
+		Voice* victim = nullptr;
+		for (Voice& v : voices) {
+			if (v.priority > priority) continue;
+			if (!victim || v.priority < victim->priority ||
+				(v.priority == victim->priority && v.cursor > victim->cursor)) {
+				victim = &v;
+			}
+		}
+		return victim;
+	}
+
+	static constexpr int C_SAMPLE_RATE = 44100;
+	static constexpr int C_STREAM_FRAMES = 512;
+	static constexpr int C_MAX_VOICES = 32;
+	static constexpr uint32_t C_RING_BATCHES = 64;
+	static constexpr int C_CATEGORY_LIMIT[static_cast<int>(SfxCategory::COUNT)] = { 8, 8, 10, 6 };
+
+	SoundBank bank;
+	AudioStream stream{};
+	bool ready = false;
+
+	// Game thread
+	Batch pending;
+	int pendingSlot[static_cast<int>(Sfx::COUNT)];
+
+	// Shared, single producer / single consumer
+	Batch ring[C_RING_BATCHES];
+	std::atomic<uint32_t> head{ 0 };
+	std::atomic<uint32_t> tail{ 0 };
+	std::atomic<int> activeVoices{ 0 };
+
+	// Audio thread
+	Voice voices[C_MAX_VOICES];
+	int categoryVoices[static_cast<int>(SfxCategory::COUNT)]{};
 };
 
 // --- ASTEROID HIERARCHY ---
 enum class WeaponType { LASER = 0, BULLET = 1, COUNT = 2 };
+
+// Bullet patterns an asteroid type can fire, compiled in the BULLET PATTERNS section
+enum class PatternId : uint8_t { NONE = 0, CROSS, SPIRAL, AIMED_FAN, FLOWER, COUNT };
+
+// Interpreter registers of one emitter
+struct PatternState {
+	static constexpr int C_MAX_DEPTH = 4;
+	struct Loop {
+		uint16_t start;
+		uint16_t left;   // 0 repeats forever
+	};
+	uint16_t pc = 0;
+	uint8_t depth = 0;
+	float heading = -90.f;   // degrees, -90 points up
+	float speed = 0.f;       // 0 uses the weapon's speed
+	Loop loops[C_MAX_DEPTH];
+};
+
+// Compact asteroid state for the parts of the world outside the active area
+struct Rock {
+	Vector2 position;
+	Vector2 velocity;
+	float rotation;
+	float rotationSpeed;
+	uint32_t next;      // intrusive sector list
+	uint8_t sides;
+	uint8_t size;
+	uint8_t weapon;
+};
+
 class Asteroid {
 public:
-	Asteroid(int screenW, int screenH) {
-		init(screenW, screenH);
+	// New asteroid entering the view from one of its edges
+	Asteroid(const Rectangle& view, int n) {
+		sides = n;
+		init(view);
+		spawnTime = gameTime;
+	}
+	Asteroid(const Rock& rock) {
+		sides = rock.sides;
+		render.size = static_cast<Renderable::Size>(rock.size);
+		weapon = static_cast<WeaponType>(rock.weapon);
+		transform.position = rock.position;
+		transform.rotation = rock.rotation;
+		physics.velocity = rock.velocity;
+		physics.rotationSpeed = rock.rotationSpeed;
+		spawnTime = gameTime;
+	}
+	virtual ~Asteroid() {
+		TimerWheel::Instance().Cancel(emitterTimer);
 	}
-	virtual ~Asteroid() = default;
 
-	bool Update(float dt) {
-		if (!isPaused) {
-			transform.position = Vector2Add(transform.position, Vector2Scale(physics.velocity, dt));
-			transform.rotation += physics.rotationSpeed * dt;
-		}
+	// Asteroids live in a fixed pool so spawning does not touch the heap
+	static void* operator new(size_t size);
+	static void operator delete(void* p);
+	static constexpr size_t C_POOL_SIZE = 1024;
+	static constexpr int C_MAX_SIDES = 6;
+
+	// Game time at which the asteroid will have fully left the area
+	void PlanExit(const Rectangle& area) {
+		Rectangle reach = { area.x - GetRadius(), area.y - GetRadius(), area.width + 2.f * GetRadius(),
+			area.height + 2.f * GetRadius() };
+		exitTime = gameTime + Utils::ExitTime(GetPosition(), physics.velocity, reach);
+	}
 
-		if (transform.position.x < -GetRadius() || transform.position.x > Renderer::Instance().Width() + GetRadius() ||
-			transform.position.y < -GetRadius() || transform.position.y > Renderer::Instance().Height() + GetRadius())
-			return false;
-		return true;
+	double ExitTime() const {
+		return exitTime;
+	}
+
+	// Asteroid drifting in a random direction, same ranges as the ones entering the view
+	static Rock RandomRock(Vector2 pos) {
+		Rock r{};
+		r.position = pos;
+		float ang = Utils::RandomFloat(0, 2 * PI);
+		r.velocity = Vector2Scale({ cosf(ang), sinf(ang) }, Utils::RandomFloat(SPEED_MIN, SPEED_MAX));
+		r.rotation = Utils::RandomFloat(0, 360);
+		r.rotationSpeed = Utils::RandomFloat(ROT_MIN, ROT_MAX);
+		r.sides = static_cast<uint8_t>(3 + GetRandomValue(0, 2));
+		r.size = static_cast<uint8_t>(1 << GetRandomValue(0, 2));
+		r.weapon = static_cast<uint8_t>(GetRandomValue(0, 1));
+		return r;
+	}
+
+	Rock ToRock() const {
+		Evaluate();
+		Rock r{};
+		r.position = position;
+		r.velocity = physics.velocity;
+		r.rotation = rotation;
+		r.rotationSpeed = physics.rotationSpeed;
+		r.sides = static_cast<uint8_t>(sides);
+		r.size = static_cast<uint8_t>(render.size);
+		r.weapon = static_cast<uint8_t>(weapon);
+		return r;
+	}
+	virtual void Draw() const {
+		Evaluate();
+		Renderer::Instance().SubmitOutline(Renderer::Layer::ASTEROIDS, vertices, sides, WHITE);
+	}
+
+	// Cheap test against the bounding circle
+	bool BoundsOverlap(Vector2 c, float r) const {
+		float reach = r + GetRadius();
+		return Vector2DistanceSqr(c, GetPosition()) < reach * reach;
+	}
+
+	// Exact test against the outline, for projectiles and ships
+	bool Hits(Vector2 c, float r) const {
+		return BoundsOverlap(c, r) && Collision::CircleVsPolygon(c, r, vertices, sides);
+	}
+
+	bool Overlaps(const Asteroid& other) const {
+		other.Evaluate();
+		return BoundsOverlap(other.position, other.GetRadius()) &&
+			Collision::PolygonVsPolygon(vertices, sides, other.vertices, other.sides);
 	}
-	virtual void Draw() const = 0;
 
 	Vector2 GetPosition() const {
-		return transform.position;
+		Evaluate();
+		return position;
 	}
 
 	float constexpr GetRadius() const {
@@ -121,20 +1929,45 @@ public:
 		return static_cast<int>(render.size);
 	}
 	bool doesShoot() const {
-		return shoot;
+		return pattern != PatternId::NONE;
+	}
+	PatternId GetPattern() const {
+		return pattern;
 	}
-	float GetBullets() const {
-		return bullets;
+	PatternState& Emitter() {
+		return emitter;
 	}
-	void SetBullets(float blt) {
-		bullets -= blt;
+	// Wakes the emitter after its next wait, cancelled with the asteroid
+	void SetEmitterTimer(TimerId id) {
+		emitterTimer = id;
 	}
 	WeaponType getWeapon() const{
 		return weapon;
 	}
 
 protected:
-	void init(int screenW, int screenH) {
+	// Position and world-space outline at the current game time, worked out on first use in a tick
+	// and shared by collision and drawing
+	void Evaluate() const {
+		if (evaluatedAt == gameTime) return;
+		evaluatedAt = gameTime;
+		float t = static_cast<float>(gameTime - spawnTime);
+		position = Vector2Add(transform.position, Vector2Scale(physics.velocity, t));
+		rotation = transform.rotation + physics.rotationSpeed * t;
+		float ang = rotation * DEG2RAD;
+		float step = 2.f * PI / sides;
+		float cs = cosf(step);
+		float sn = sinf(step);
+		Vector2 d = { cosf(ang) * GetRadius(), sinf(ang) * GetRadius() };
+		for (int i = 0; i < sides; ++i) {
+			vertices[i] = Vector2Add(position, d);
+			d = { d.x * cs - d.y * sn, d.x * sn + d.y * cs };
+		}
+	}
+
+	void init(const Rectangle& view) {
+		float screenW = view.width;
+		float screenH = view.height;
 		// Choose size
 		render.size = static_cast<Renderable::Size>(1 << GetRandomValue(0, 2));
 		weapon = static_cast<WeaponType>(GetRandomValue(0, 1));
@@ -163,122 +1996,428 @@ protected:
 										 screenH * 0.5f + sinf(ang) * rad
 		};
 
-		Vector2 dir = Vector2Normalize(Vector2Subtract(center, transform.position));
-		physics.velocity = Vector2Scale(dir, Utils::RandomFloat(SPEED_MIN, SPEED_MAX));
-		physics.rotationSpeed = Utils::RandomFloat(ROT_MIN, ROT_MAX);
+		Vector2 dir = Vector2Normalize(Vector2Subtract(center, transform.position));
+		physics.velocity = Vector2Scale(dir, Utils::RandomFloat(SPEED_MIN, SPEED_MAX));
+		physics.rotationSpeed = Utils::RandomFloat(ROT_MIN, ROT_MAX);
+
+		transform.rotation = Utils::RandomFloat(0, 360);
+		transform.position = Vector2Add(transform.position, { view.x, view.y });
+	}
+
+	TransformA transform;   // at spawnTime
+	Physics    physics;
+	Renderable render;
+	double spawnTime = 0.0;
+	double exitTime = INFINITY;
+
+	int baseDamage = 0;
+	PatternId pattern = PatternId::NONE;
+	PatternState emitter;
+	TimerId emitterTimer = 0;
+	int sides = 3;
+	mutable double evaluatedAt = -1.0;
+	mutable Vector2 position{};
+	mutable float rotation = 0.f;
+	mutable Vector2 vertices[C_MAX_SIDES];
+	WeaponType weapon = WeaponType::LASER;
+	static constexpr float LIFE = 10.f;
+	static constexpr float SPEED_MIN = 125.f;
+	static constexpr float SPEED_MAX = 250.f;
+	static constexpr float ROT_MIN = 50.f;
+	static constexpr float ROT_MAX = 240.f;
+};
+
+class TriangleAsteroid : public Asteroid {
+public:
+	TriangleAsteroid(const Rectangle& view) : Asteroid(view, 3) { baseDamage = 5; }
+	TriangleAsteroid(const Rock& rock) : Asteroid(rock) { baseDamage = 5; }
+};
+class SquareAsteroid : public Asteroid {
+public:
+	SquareAsteroid(const Rectangle& view) : Asteroid(view, 4) { baseDamage = 10; }
+	SquareAsteroid(const Rock& rock) : Asteroid(rock) { baseDamage = 10; }
+};
+class PentagonAsteroid : public Asteroid {
+public:
+	PentagonAsteroid(const Rectangle& view) : Asteroid(view, 5) { baseDamage = 15; }
+	PentagonAsteroid(const Rock& rock) : Asteroid(rock) { baseDamage = 15; }
+};
+class HexagonAsteroid : public Asteroid {
+public:
+	HexagonAsteroid(const Rectangle& view) : Asteroid(view, 6) { baseDamage = 20; pattern = PatternId::CROSS; }
+	HexagonAsteroid(const Rock& rock) : Asteroid(rock) { baseDamage = 20; pattern = PatternId::CROSS; }
+};
+
+static BlockPool<std::max({ sizeof(TriangleAsteroid), sizeof(SquareAsteroid), sizeof(PentagonAsteroid), sizeof(HexagonAsteroid) }),
+	Asteroid::C_POOL_SIZE> asteroidPool;
+
+void* Asteroid::operator new(size_t size) {
+	return asteroidPool.Alloc(size);
+}
+
+void Asteroid::operator delete(void* p) {
+	asteroidPool.Free(p);
+}
+
+// Shape selector
+enum class AsteroidShape { TRIANGLE = 3, SQUARE = 4, PENTAGON = 5, HEXAGON = 6, RANDOM = 0 };
+
+// Factory
+struct AsteroidExit {
+	double operator()(const std::unique_ptr<Asteroid>& a) const {
+		return a->ExitTime();
+	}
+};
+
+static inline std::unique_ptr<Asteroid> MakeAsteroid(const Rectangle& view, AsteroidShape shape) {
+	switch (shape) {
+	case AsteroidShape::TRIANGLE:
+		return std::make_unique<TriangleAsteroid>(view);
+	case AsteroidShape::SQUARE:
+		return std::make_unique<SquareAsteroid>(view);
+	case AsteroidShape::PENTAGON:
+		return std::make_unique<PentagonAsteroid>(view);
+	case AsteroidShape::HEXAGON:
+		return std::make_unique<HexagonAsteroid>(view);
+	default: {
+		return MakeAsteroid(view, static_cast<AsteroidShape>(3 + GetRandomValue(0, 2)));
+	}
+	}
+}
+
+static inline std::unique_ptr<Asteroid> MakeAsteroid(const Rock& rock) {
+	switch (rock.sides) {
+	case 3:
+		return std::make_unique<TriangleAsteroid>(rock);
+	case 4:
+		return std::make_unique<SquareAsteroid>(rock);
+	case 5:
+		return std::make_unique<PentagonAsteroid>(rock);
+	default:
+		return std::make_unique<HexagonAsteroid>(rock);
+	}
+}
+
+// --- WORLD ---
+// Large world split into square sectors. Asteroids outside the active sectors around the camera
+// are stored as rocks in per-sector lists: nearby sectors tick at reduced rates, distant ones are
+// left alone and catch up analytically when the camera comes close. Per-frame cost depends on the
+// area around the camera, not on the size of the world. Rocks bounce off the world edges.
+class World {
+public:
+	static constexpr int C_SECTOR_SIZE = 1024;
+	static constexpr int C_SECTORS = 320;                  // per side
+	static constexpr float C_SIZE = static_cast<float>(C_SECTOR_SIZE * C_SECTORS);
+
+	// Scatter count rocks, keeping a clear area around the start position
+	void Generate(size_t count, Vector2 clearCenter, float clearRadius) {
+		rocks.resize(count);
+		sectors.assign(static_cast<size_t>(C_SECTORS) * C_SECTORS, Sector{});
+		freeHead = C_NONE;
+		Grow();
+		stored = 0;
+		now = 0.0;
+		frame = 0;
+		camX = camY = C_NO_SECTOR;
+		woken.clear();
+		woken.reserve(C_MAX_WOKEN);
+		wakeLimit = C_MAX_WOKEN;
+		for (size_t i = 0; i < count; ++i) {
+			Vector2 pos;
+			do {
+				pos = { Utils::RandomFloat(0, C_SIZE), Utils::RandomFloat(0, C_SIZE) };
+			} while (Vector2DistanceSqr(pos, clearCenter) < clearRadius * clearRadius);
+			rocks[i] = Asteroid::RandomRock(pos);
+			Place(static_cast<uint32_t>(i));
+		}
+		TraceLog(LOG_INFO, "WORLD: %d rocks in %dx%d sectors of %d px", static_cast<int>(count), C_SECTORS, C_SECTORS,
+			C_SECTOR_SIZE);
+	}
+
+	// New run in the same world: forget the camera so nothing counts as active and live asteroids
+	// can be stored back without being woken again. Clear the start area after storing them.
+	void Restart() {
+		camX = camY = C_NO_SECTOR;
+		woken.clear();
+	}
+
+	// Push stored rocks near the start position out to the edge of the clear area
+	void ClearArea(Vector2 clearCenter, float clearRadius) {
+		int x0 = SectorCoord(clearCenter.x - clearRadius);
+		int y0 = SectorCoord(clearCenter.y - clearRadius);
+		int x1 = SectorCoord(clearCenter.x + clearRadius);
+		int y1 = SectorCoord(clearCenter.y + clearRadius);
+		for (int sy = y0; sy <= y1; ++sy) {
+			for (int sx = x0; sx <= x1; ++sx) {
+				const Sector& s = sectors[SectorIndex(sx, sy)];
+				float age = static_cast<float>(now - s.time);
+				for (uint32_t i = s.head; i != C_NONE; i = rocks[i].next) {
+					Rock& r = rocks[i];
+					// Shift the stored state so the rock is on the edge of the clear area now
+					Vector2 offset = Vector2Subtract(Vector2Add(r.position, Vector2Scale(r.velocity, age)), clearCenter);
+					float distance = Vector2Length(offset);
+					if (distance >= clearRadius) continue;
+					Vector2 out = (distance > 0.f) ? Vector2Scale(offset, 1.f / distance) : Vector2{ 1.f, 0.f };
+					r.position = Vector2Add(r.position, Vector2Scale(out, clearRadius - distance));
+				}
+			}
+		}
+	}
+
+	// Advance world time, wake sectors entering the active area and tick the rings around it.
+	// At most room rocks are woken, the rest wait in their sector until there is room.
+	void Update(Vector2 focus, float dt, size_t room) {
+		now += dt;
+		wakeLimit = std::min(room, C_MAX_WOKEN);
+		frame++;
+		ticked = 0;
+		int cx = SectorCoord(focus.x);
+		int cy = SectorCoord(focus.y);
+		if (cx != camX || cy != camY) {
+			int oldX = camX;
+			int oldY = camY;
+			camX = cx;
+			camY = cy;
+			for (int sy = cy - 1; sy <= cy + 1; ++sy) {
+				for (int sx = cx - 1; sx <= cx + 1; ++sx) {
+					bool wasActive = abs(sx - oldX) <= 1 && abs(sy - oldY) <= 1;
+					// Catching up relinks the rocks into an active sector, which hands them out
+					if (Valid(sx, sy) && !wasActive) {
+						Advance(SectorIndex(sx, sy));
+					}
+				}
+			}
+		}
+		for (int sy = cy - C_FAR_RING; sy <= cy + C_FAR_RING; ++sy) {
+			for (int sx = cx - C_FAR_RING; sx <= cx + C_FAR_RING; ++sx) {
+				int ring = std::max(abs(sx - cx), abs(sy - cy));
+				if (!Valid(sx, sy)) continue;
+				size_t index = SectorIndex(sx, sy);
+				if (sectors[index].head == C_NONE) continue;
+				// Active sectors only hold rocks that could not be woken, retry while there is room
+				if (ring <= 1) {
+					if (woken.size() < wakeLimit) {
+						Advance(index);
+					}
+					continue;
+				}
+				// Stagger so each frame ticks a slice of the ring
+				int period = (ring <= C_NEAR_RING) ? C_NEAR_PERIOD : C_FAR_PERIOD;
+				if ((sx + sy * 7 + frame) % period == 0) {
+					Advance(index);
+				}
+			}
+		}
+	}
+
+	// Hand an asteroid that left the active area back to the world
+	void Store(const Rock& rock) {
+		if (freeHead == C_NONE) {
+			Grow();
+			TraceLog(LOG_WARNING, "WORLD: rock storage full, grown to %d", static_cast<int>(rocks.size()));
+		}
+		uint32_t i = freeHead;
+		freeHead = rocks[i].next;
+		rocks[i] = rock;
+		Bounce(rocks[i]);
+		Place(i);
+	}
+
+	// Rocks that entered the active area since the last ClearWoken(), to be turned into asteroids
+	const std::vector<Rock>& Woken() const {
+		return woken;
+	}
+
+	void ClearWoken() {
+		woken.clear();
+	}
+
+	// The 3x3 sectors around the camera, where asteroids are simulated in full
+	Rectangle ActiveArea() const {
+		float x0 = fmaxf(0.f, static_cast<float>((camX - 1) * C_SECTOR_SIZE));
+		float y0 = fmaxf(0.f, static_cast<float>((camY - 1) * C_SECTOR_SIZE));
+		float x1 = fminf(C_SIZE, static_cast<float>((camX + 2) * C_SECTOR_SIZE));
+		float y1 = fminf(C_SIZE, static_cast<float>((camY + 2) * C_SECTOR_SIZE));
+		return { x0, y0, x1 - x0, y1 - y0 };
+	}
+
+	// Rocks in sector storage, live asteroids not included
+	size_t Stored() const {
+		return stored;
+	}
 
-		transform.rotation = Utils::RandomFloat(0, 360);
+	// Rocks advanced by the last Update()
+	int Ticked() const {
+		return ticked;
 	}
 
-	TransformA transform;
-	Physics    physics;
-	Renderable render;
+private:
+	struct Sector {
+		uint32_t head = C_NONE;
+		double time = 0.0;      // world time the rocks' state refers to
+	};
 
-	int baseDamage = 0;
-	bool shoot = false;
-	float bullets = 20.0f;
-	WeaponType weapon;
-	static constexpr float LIFE = 10.f;
-	static constexpr float SPEED_MIN = 125.f;
-	static constexpr float SPEED_MAX = 250.f;
-	static constexpr float ROT_MIN = 50.f;
-	static constexpr float ROT_MAX = 240.f;
-};
+	static int SectorCoord(float v) {
+		return std::clamp(static_cast<int>(floorf(v / C_SECTOR_SIZE)), 0, C_SECTORS - 1);
+	}
 
-class TriangleAsteroid : public Asteroid {
-public:
-	TriangleAsteroid(int w, int h) : Asteroid(w, h) { baseDamage = 5; shoot = false; }
-	void Draw() const override {
-		Renderer::Instance().DrawPoly(transform.position, 3, GetRadius(), transform.rotation);
+	static bool Valid(int sx, int sy) {
+		return sx >= 0 && sy >= 0 && sx < C_SECTORS && sy < C_SECTORS;
 	}
-};
-class SquareAsteroid : public Asteroid {
-public:
-	SquareAsteroid(int w, int h) : Asteroid(w, h) { baseDamage = 10; shoot = false; }
-	void Draw() const override {
-		Renderer::Instance().DrawPoly(transform.position, 4, GetRadius(), transform.rotation);
+
+	static size_t SectorIndex(int sx, int sy) {
+		return static_cast<size_t>(sy) * C_SECTORS + sx;
 	}
-};
-class PentagonAsteroid : public Asteroid {
-public:
-	PentagonAsteroid(int w, int h) : Asteroid(w, h) { baseDamage = 15; shoot = false; }
-	void Draw() const override {
-		Renderer::Instance().DrawPoly(transform.position, 5, GetRadius(), transform.rotation);
+
+	bool IsActive(int sx, int sy) const {
+		return abs(sx - camX) <= 1 && abs(sy - camY) <= 1;
 	}
-};
-class HexagonAsteroid : public Asteroid {
-public:
-	HexagonAsteroid(int w, int h) : Asteroid(w, h) { baseDamage = 20; shoot = true; }
-	void Draw() const override {
-		Renderer::Instance().DrawPoly(transform.position, 6, GetRadius(), transform.rotation);
+
+	// Fold a straight path back into the world, reflecting velocity for every odd bounce
+	static void Bounce(Rock& r) {
+		auto fold = [](float& p, float& v) {
+			float m = fmodf(p, 2.f * C_SIZE);
+			if (m < 0.f) m += 2.f * C_SIZE;
+			if (m > C_SIZE) {
+				p = 2.f * C_SIZE - m;
+				v = -v;
+			}
+			else {
+				p = m;
+			}
+		};
+		fold(r.position.x, r.velocity.x);
+		fold(r.position.y, r.velocity.y);
 	}
-};
 
-// Shape selector
-enum class AsteroidShape { TRIANGLE = 3, SQUARE = 4, PENTAGON = 5, HEXAGON = 6, RANDOM = 0 };
+	// Spare storage for asteroids spawned during the run and later handed to the world
+	void Grow() {
+		size_t used = rocks.size();
+		rocks.resize(used + C_SPARE_ROCKS);
+		for (size_t i = rocks.size(); i-- > used;) {
+			rocks[i].next = freeHead;
+			freeHead = static_cast<uint32_t>(i);
+		}
+	}
 
-// Factory
-static inline std::unique_ptr<Asteroid> MakeAsteroid(int w, int h, AsteroidShape shape) {
-	switch (shape) {
-	case AsteroidShape::TRIANGLE:
-		return std::make_unique<TriangleAsteroid>(w, h);
-	case AsteroidShape::SQUARE:
-		return std::make_unique<SquareAsteroid>(w, h);
-	case AsteroidShape::PENTAGON:
-		return std::make_unique<PentagonAsteroid>(w, h);
-	case AsteroidShape::HEXAGON:
-		return std::make_unique<HexagonAsteroid>(w, h);
-	default: {
-		return MakeAsteroid(w, h, static_cast<AsteroidShape>(3 + GetRandomValue(0, 2)));
+	// Link a rock, already valid at the current time, into the sector it is in
+	void Place(uint32_t i) {
+		Rock& r = rocks[i];
+		int sx = SectorCoord(r.position.x);
+		int sy = SectorCoord(r.position.y);
+		if (IsActive(sx, sy) && woken.size() < wakeLimit) {
+			woken.push_back(r);
+			r.next = freeHead;
+			freeHead = i;
+			return;
+		}
+		Sector& s = sectors[SectorIndex(sx, sy)];
+		// Rewind to the sector's clock so one catch-up step moves every rock in it
+		float back = static_cast<float>(now - s.time);
+		r.position = Vector2Subtract(r.position, Vector2Scale(r.velocity, back));
+		r.rotation -= r.rotationSpeed * back;
+		r.next = s.head;
+		s.head = i;
+		stored++;
 	}
+
+	// Move every rock of a sector to the current time, rocks that crossed a border change lists
+	void Advance(size_t index) {
+		Sector& s = sectors[index];
+		float dt = static_cast<float>(now - s.time);
+		s.time = now;
+		uint32_t i = s.head;
+		s.head = C_NONE;
+		while (i != C_NONE) {
+			Rock& r = rocks[i];
+			uint32_t next = r.next;
+			r.position = Vector2Add(r.position, Vector2Scale(r.velocity, dt));
+			r.rotation = fmodf(r.rotation + r.rotationSpeed * dt, 360.f);
+			Bounce(r);
+			stored--;
+			Place(i);
+			ticked++;
+			i = next;
+		}
 	}
-}
+
+	static constexpr uint32_t C_NONE = 0xFFFFFFFF;
+	static constexpr int C_NO_SECTOR = -1000;
+	static constexpr int C_NEAR_RING = 3;
+	static constexpr int C_FAR_RING = 8;
+	static constexpr int C_NEAR_PERIOD = 4;
+	static constexpr int C_FAR_PERIOD = 32;
+	static constexpr size_t C_SPARE_ROCKS = 65536;
+	static constexpr size_t C_MAX_WOKEN = 4096;
+
+	std::vector<Rock> rocks;
+	std::vector<Sector> sectors;
+	std::vector<Rock> woken;
+	uint32_t freeHead = C_NONE;
+	size_t wakeLimit = C_MAX_WOKEN;
+	size_t stored = 0;
+	double now = 0.0;
+	int frame = 0;
+	int camX = C_NO_SECTOR;
+	int camY = C_NO_SECTOR;
+	int ticked = 0;
+};
 
 // --- PROJECTILE HIERARCHY ---
 //enum class WeaponType { LASER = 0, BULLET = 1, COUNT = 2 };
 class Projectile {
 public:
-	Projectile(Vector2 pos, Vector2 vel, int dmg, WeaponType wt)
+	Projectile() = default;
+	// Fired at game time `time`, retired once it has left `area`
+	Projectile(Vector2 pos, Vector2 vel, int dmg, WeaponType wt, double time, const Rectangle& area)
 	{
 		transform.position = pos;
 		physics.velocity = vel;
 		baseDamage = dmg;
 		type = wt;
+		spawnTime = time;
+		PlanExit(area, time);
 	}
-	bool Update(float dt) {
-		if (!isPaused) {
-			transform.position = Vector2Add(transform.position, Vector2Scale(physics.velocity, dt));
-		}
 
-		if (transform.position.x < 0 ||
-			transform.position.x > Renderer::Instance().Width() ||
-			transform.position.y < 0 ||
-			transform.position.y > Renderer::Instance().Height())
-		{
-			return true;
-		}
-		return false;
+	// Game time at which the projectile will have left the area, seen from game time `now`
+	void PlanExit(const Rectangle& area, double now) {
+		Vector2 position = Vector2Add(transform.position, Vector2Scale(physics.velocity, static_cast<float>(now - spawnTime)));
+		exitTime = now + Utils::ExitTime(position, physics.velocity, area);
+	}
+
+	double ExitTime() const {
+		return exitTime;
 	}
-	void Draw() const {
+
+	void Draw(const Rectangle& view) const {
+		Vector2 position = GetPosition();
+		if (!CheckCollisionCircleRec(position, C_DRAW_REACH, view)) return;
 		if (type == WeaponType::BULLET) {
-			DrawCircleV(transform.position, 5.f, WHITE);
+			// A quad instead of a 36 segment circle while the governor sheds load
+			if (FrameGovernor::Instance().Applies(GovernorLevel::SIMPLE_DRAWS)) {
+				Renderer::Instance().SubmitRect(Renderer::Layer::PROJECTILES,
+					{ position.x - 4.f, position.y - 4.f, 8.f, 8.f }, WHITE);
+			}
+			else {
+				Renderer::Instance().SubmitCircle(Renderer::Layer::PROJECTILES, position, 5.f, WHITE);
+			}
 		}
 		else {
 			static constexpr float LASER_LENGTH = 30.f;
 			Rectangle lr = { 0.f, 0.f, 1.f, 1.f };
 			float xs = sgn(physics.velocity.x);
 			float ys = sgn(physics.velocity.y);
-			if (physics.velocity.x != 0) {
-				lr = { transform.position.x - xs * LASER_LENGTH, transform.position.y - ys * 2.f, LASER_LENGTH, 4.f };
+			if (fabsf(physics.velocity.x) > fabsf(physics.velocity.y)) {
+				lr = { position.x - xs * LASER_LENGTH, position.y - ys * 2.f, LASER_LENGTH, 4.f };
 			}
 			else {
-				lr = { transform.position.x - xs * 2.f, transform.position.y - ys * LASER_LENGTH, 4.f, LASER_LENGTH };
+				lr = { position.x - xs * 2.f, position.y - ys * LASER_LENGTH, 4.f, LASER_LENGTH };
 			}
-			DrawRectangleRec(lr, RED);
+			Renderer::Instance().SubmitRect(Renderer::Layer::PROJECTILES, lr, RED);
 		}
 	}
 	Vector2 GetPosition() const {
-		return transform.position;
+		return Vector2Add(transform.position, Vector2Scale(physics.velocity, static_cast<float>(gameTime - spawnTime)));
 	}
 
 	float GetRadius() const {
@@ -290,26 +2429,290 @@ public:
 	}
 
 private:
-	TransformA transform;
+	static constexpr float C_DRAW_REACH = 32.f;   // laser length past the position
+
+	TransformA transform;   // at spawnTime
 	Physics    physics;
-	int        baseDamage;
-	WeaponType type;
+	double     spawnTime = 0.0;
+	double     exitTime = 0.0;
+	int        baseDamage = 0;
+	WeaponType type = WeaponType::BULLET;
+};
+
+struct ProjectileExit {
+	double operator()(const Projectile& p) const {
+		return p.ExitTime();
+	}
 };
 
 inline static Projectile MakeProjectile(WeaponType wt,
 	const Vector2 pos,
 	float speedx,
-	float speedy)
+	float speedy,
+	double time,
+	const Rectangle& area)
 {
 	Vector2 vel{ speedx, -speedy };
 	if (wt == WeaponType::LASER) {
-		return Projectile(pos, vel, 20, wt);
+		return Projectile(pos, vel, 20, wt, time, area);
 	}
 	else {
-		return Projectile(pos, vel, 10, wt);
+		return Projectile(pos, vel, 10, wt, time, area);
 	}
 }
 
+// --- BULLET PATTERNS ---
+// Patterns are written in a small language and compiled to bytecode once at startup:
+//   ring N            N shots spread evenly around the heading
+//   spread N ARC      N shots fanned over ARC degrees, centered on the heading
+//   aim               turn the heading towards the target
+//   turn DEG          rotate the heading
+//   speed V           shot speed in px/s, 0 goes back to the weapon's speed
+//   wait T            yield the emitter for T seconds
+//   repeat N ... end  run the block N times, 0 forever
+// An emitter runs until its next wait and appends the whole volley to the projectile store at once.
+struct EmitContext {
+	Vector2 origin;
+	float radius;      // shots start on this circle around the origin
+	Vector2 target;
+	WeaponType weapon;
+	double time;       // game time of the volley
+	Rectangle area;    // shots are retired once they leave it
+};
+
+class BulletPatterns {
+public:
+	static BulletPatterns& Instance() {
+		static BulletPatterns inst;
+		return inst;
+	}
+
+	static constexpr size_t C_MAX_VOLLEY = 1024;
+
+	// Broken patterns are reported and left empty
+	void Compile() {
+		if (!code.empty()) return;
+		code.push_back({ Op::END, 0, 0.f });
+		for (int id = 1; id < static_cast<int>(PatternId::COUNT); ++id) {
+			size_t start = code.size();
+			entry[id] = static_cast<uint16_t>(start);
+			if (!CompileSource(C_SOURCES[id].name, C_SOURCES[id].source)) {
+				code.resize(start);
+				entry[id] = 0;
+			}
+		}
+		TraceLog(LOG_INFO, "PATTERN: %d patterns compiled to %d instructions", static_cast<int>(PatternId::COUNT) - 1,
+			static_cast<int>(code.size()));
+	}
+
+	void Start(PatternState& st, PatternId id) const {
+		st = PatternState{};
+		st.pc = entry[static_cast<int>(id)];
+	}
+
+	// Appends at most `room` shots to out, returns the seconds until the next volley or -1 once the pattern ended
+	// The shots are left in LastVolley() until the next Run
+	float Run(PatternState& st, const EmitContext& ctx, size_t room) {
+		const size_t limit = std::min(room, C_MAX_VOLLEY);
+		size_t n = 0;
+		float wait = -1.f;
+		bool running = true;
+		for (int steps = 0; running && steps < C_MAX_STEPS; ++steps) {
+			const Instr& in = code[st.pc++];
+			switch (in.op) {
+			case Op::RING:
+				n = Fan(st, ctx, in.count, st.heading, 360.f / in.count, n, limit);
+				break;
+			case Op::SPREAD:
+				n = Fan(st, ctx, in.count, st.heading - in.value * 0.5f, (in.count > 1) ? in.value / (in.count - 1) : 0.f,
+					n, limit);
+				break;
+			case Op::AIM:
+				st.heading = atan2f(ctx.target.y - ctx.origin.y, ctx.target.x - ctx.origin.x) * RAD2DEG;
+				break;
+			case Op::TURN:
+				st.heading = fmodf(st.heading + in.value, 360.f);
+				break;
+			case Op::SPEED:
+				st.speed = in.value;
+				break;
+			case Op::WAIT:
+				wait = in.value;
+				running = false;
+				break;
+			case Op::REPEAT:
+				st.loops[st.depth++] = { st.pc, in.count };
+				break;
+			case Op::LOOP: {
+				PatternState::Loop& loop = st.loops[st.depth - 1];
+				if (loop.left == 0 || --loop.left > 0) st.pc = loop.start;
+				else --st.depth;
+				break;
+			}
+			case Op::END:
+				--st.pc;
+				running = false;
+				break;
+			}
+		}
+		volleySize = n;
+		return wait;
+	}
+
+	std::span<const Projectile> LastVolley() const {
+		return { volley, volleySize };
+	}
+
+	// Steps `emitters` emitters cycling through every pattern at 60 Hz and reports the emission rate.
+	// Volleys go into the same exit queue the game uses, shots leaving the row's area are retired.
+	void Benchmark(int emitters, float seconds) {
+		std::vector<PatternState> states(emitters);
+		std::vector<float> due(emitters, 0.f);
+		const size_t capacity = static_cast<size_t>(emitters) * C_BENCH_SHOTS_PER_EMITTER;
+		ExitQueue<Projectile, ProjectileExit> store;
+		store.Reserve(capacity);
+		for (int i = 0; i < emitters; ++i) {
+			Start(states[i], static_cast<PatternId>(1 + i % (static_cast<int>(PatternId::COUNT) - 1)));
+		}
+		const float dt = 1.f / 60.f;
+		const Rectangle area = { -C_BENCH_REACH, -C_BENCH_REACH, 50.f * emitters + 2.f * C_BENCH_REACH, 2.f * C_BENCH_REACH };
+		long long shots = 0;
+		long long volleys = 0;
+		double busy = 0.0;
+		for (float t = 0.f; t < seconds; t += dt) {
+			double start = GetTime();
+			store.RetireUntil(t);
+			for (int i = 0; i < emitters; ++i) {
+				EmitContext ctx{ { 50.f * i, 0.f }, 40.f, { 0.f, 500.f }, (i & 1) ? WeaponType::LASER : WeaponType::BULLET, t,
+					area };
+				while (due[i] >= 0.f && due[i] <= t) {
+					float wait = Run(states[i], ctx, capacity - store.Size());
+					store.Append(LastVolley());
+					shots += static_cast<long long>(LastVolley().size());
+					due[i] = (wait < 0.f) ? -1.f : due[i] + std::max(wait, dt);
+					++volleys;
+				}
+			}
+			busy += GetTime() - start;
+		}
+		printf("BENCH patterns %d emitters, %.0f s: %lld volleys, %lld projectiles in %.3f ms, %.0f projectiles/ms\n",
+			emitters, seconds, volleys, shots, 1000.0 * busy, busy > 0.0 ? shots / (1000.0 * busy) : 0.0);
+	}
+
+private:
+	enum class Op : uint8_t { RING, SPREAD, AIM, TURN, SPEED, WAIT, REPEAT, LOOP, END };
+	struct Instr {
+		Op op;
+		uint16_t count;
+		float value;
+	};
+	struct Source {
+		const char* name;
+		const char* source;
+	};
+
+	// Indexed by PatternId
+	static constexpr Source C_SOURCES[] = {
+		{ "none", "" },
+		{ "cross", "repeat 20 ring 4 wait 2 end" },
+		{ "spiral", "repeat 0 ring 6 turn 12 wait 0.1 end" },
+		{ "aimed fan", "repeat 0 wait 1.5 aim repeat 3 spread 5 40 wait 0.08 end end" },
+		{ "flower", "repeat 0 speed 220 ring 16 turn 11.25 speed 330 ring 16 wait 1.6 end" },
+	};
+	static_assert(sizeof(C_SOURCES) / sizeof(C_SOURCES[0]) == static_cast<size_t>(PatternId::COUNT));
+
+	static constexpr int C_MAX_STEPS = 4096;   // a pattern looping without a wait is stopped
+	static constexpr float C_LASER_SPEED = 720.f;
+	static constexpr float C_BULLET_SPEED = 440.f;
+	static constexpr float C_BENCH_REACH = 800.f;             // half a view plus the shot margin
+	static constexpr size_t C_BENCH_SHOTS_PER_EMITTER = 128;
+
+	BulletPatterns() = default;
+
+	size_t Fan(const PatternState& st, const EmitContext& ctx, int count, float first, float step, size_t n,
+		size_t limit) {
+		float speed = (st.speed > 0.f) ? st.speed : (ctx.weapon == WeaponType::LASER) ? C_LASER_SPEED : C_BULLET_SPEED;
+		Vector2 dir = { cosf(first * DEG2RAD), sinf(first * DEG2RAD) };
+		const float c = cosf(step * DEG2RAD);
+		const float s = sinf(step * DEG2RAD);
+		for (int i = 0; i < count && n < limit; ++i) {
+			Vector2 pos = { ctx.origin.x + dir.x * ctx.radius, ctx.origin.y + dir.y * ctx.radius };
+			volley[n++] = MakeProjectile(ctx.weapon, pos, dir.x * speed, -dir.y * speed, ctx.time, ctx.area);
+			dir = { dir.x * c - dir.y * s, dir.x * s + dir.y * c };
+		}
+		return n;
+	}
+
+	static bool NextToken(const char*& p, char* word, size_t size) {
+		while (*p == ' ' || *p == '\t' || *p == '\n' || *p == ';') ++p;
+		size_t len = 0;
+		while (*p && *p != ' ' && *p != '\t' && *p != '\n' && *p != ';') {
+			if (len + 1 < size) word[len++] = *p;
+			++p;
+		}
+		word[len] = '\0';
+		return len > 0;
+	}
+
+	static bool NextNumber(const char*& p, float& value) {
+		char word[32];
+		if (!NextToken(p, word, sizeof(word))) return false;
+		char* end = nullptr;
+		value = strtof(word, &end);
+		return *end == '\0';
+	}
+
+	bool CompileSource(const char* name, const char* p) {
+		int depth = 0;
+		char word[32];
+		while (NextToken(p, word, sizeof(word))) {
+			Instr in{ Op::END, 0, 0.f };
+			float count = 0.f;
+			bool ok = true;
+			if (strcmp(word, "ring") == 0 || strcmp(word, "spread") == 0) {
+				in.op = (word[0] == 'r') ? Op::RING : Op::SPREAD;
+				ok = NextNumber(p, count) && count >= 1.f && count <= static_cast<float>(C_MAX_VOLLEY) &&
+					(in.op == Op::RING || NextNumber(p, in.value));
+			}
+			else if (strcmp(word, "aim") == 0) {
+				in.op = Op::AIM;
+			}
+			else if (strcmp(word, "turn") == 0 || strcmp(word, "speed") == 0 || strcmp(word, "wait") == 0) {
+				in.op = (word[0] == 't') ? Op::TURN : (word[0] == 's') ? Op::SPEED : Op::WAIT;
+				ok = NextNumber(p, in.value) && (in.op == Op::TURN || in.value >= 0.f);
+			}
+			else if (strcmp(word, "repeat") == 0) {
+				in.op = Op::REPEAT;
+				ok = NextNumber(p, count) && count >= 0.f && count <= UINT16_MAX && ++depth <= PatternState::C_MAX_DEPTH;
+			}
+			else if (strcmp(word, "end") == 0) {
+				in.op = Op::LOOP;
+				ok = --depth >= 0;
+			}
+			else {
+				ok = false;
+			}
+			if (!ok) {
+				TraceLog(LOG_WARNING, "PATTERN: '%s' is invalid near '%s'", name, word);
+				return false;
+			}
+			in.count = static_cast<uint16_t>(count);
+			code.push_back(in);
+		}
+		if (depth != 0) {
+			TraceLog(LOG_WARNING, "PATTERN: '%s' has an unclosed repeat", name);
+			return false;
+		}
+		code.push_back({ Op::END, 0, 0.f });
+		return true;
+	}
+
+	std::vector<Instr> code;
+	uint16_t entry[static_cast<int>(PatternId::COUNT)]{};
+	Projectile volley[C_MAX_VOLLEY];
+	size_t volleySize = 0;
+};
+
 // --- SHIP HIERARCHY ---
 class Ship {
 public:
@@ -352,6 +2755,11 @@ public:
 		return hp;
 	}
 
+	void Confine(const Rectangle& bounds) {
+		transform.position.x = Clamp(transform.position.x, bounds.x, bounds.x + bounds.width);
+		transform.position.y = Clamp(transform.position.y, bounds.y, bounds.y + bounds.height);
+	}
+
 	float GetFireRate(WeaponType wt) const {
 		return (wt == WeaponType::LASER) ? fireRateLaser : fireRateBullet;
 	}
@@ -373,29 +2781,35 @@ protected:
 
 class Consumable {
 public:
+	Consumable() = default;
 	Consumable(int val, Vector2 pos) {
 		value = GetRandomValue(val - 5, val);
 		transform.position = pos;
+		active = true;
 	}
 	int getValue() {
 		return value;
 	}
-	float getLifeTime() {
-		return lifetime;
+	bool IsActive() const {
+		return active;
 	}
-	void addLifeTime(float time) {
-		lifetime += time;
+	TimerId getExpiry() const {
+		return expiry;
+	}
+	void setExpiry(TimerId timer) {
+		expiry = timer;
 	}
 	void Draw() const{
 		Rectangle cr = { transform.position.x - 5, transform.position.y - 5, 10.f, 10.f };
-		DrawRectangleRec(cr, PINK);
+		Renderer::Instance().SubmitRect(Renderer::Layer::PICKUPS, cr, PINK);
 	}
 	Vector2 getPosition() {
 		return transform.position;
 	}
 private:
-	int value;
-	float lifetime = 0.f;
+	int value = 0;
+	bool active = false;
+	TimerId expiry = 0;
 	TransformA transform;
 };
 
@@ -430,7 +2844,7 @@ public:
 										 transform.position.x - (texture.width * scale) * 0.5f,
 										 transform.position.y - (texture.height * scale) * 0.5f
 		};
-		DrawTextureEx(texture, dstPos, 0.0f, scale, WHITE);
+		Renderer::Instance().SubmitTexture(Renderer::Layer::SHIP, texture, dstPos, scale, WHITE);
 	}
 
 	float GetRadius() const override {
@@ -450,6 +2864,25 @@ private:
 };
 
 // --- APPLICATION ---
+struct RunOptions {
+	int frames = 0;                  // stop after this many frames, 0 runs until the window is closed
+	float fixedDt = 0.f;             // simulation step, 0 uses the measured frame time
+	unsigned int seed = 0;           // 0 seeds from the clock
+	bool autopilot = false;          // scripted input: fire, strafe, switch weapon, restart
+	int dumpEvery = 0;               // save a screenshot every N frames, 0 never
+	const char* dumpPrefix = "frame";
+	bool circleHits = false;         // bounding circles only, baseline for the collision benchmark
+	bool sortDraws = true;           // group draw commands by primitive and texture
+	size_t worldRocks = 1'000'000;   // asteroids scattered over the world at start
+	bool recordAtStart = false;      // record from the first frame, F4 toggles in game
+	FrameRecorder::Format recordFormat = FrameRecorder::Format::GIF;
+	const char* recordPrefix = "capture";
+	int patternEmitters = 0;         // benchmark this many bullet pattern emitters before the run
+	bool denseScene = false;         // keep the view full of hexagons and pickups, for draw call benchmarks
+	float frameBudgetMs = 1000.f / 60.f;   // the governor sheds load above this, 0 turns it off
+	GovernorLevel maxGovernorLevel = GovernorLevel::COLLISION;
+};
+
 class Application {
 public:
 	static Application& Instance() {
@@ -457,20 +2890,63 @@ public:
 		return inst;
 	}
 
+	void SetOptions(const RunOptions& opts) {
+		options = opts;
+	}
+
 	void Run() {
-		srand(static_cast<unsigned>(time(nullptr)));
+		unsigned int seed = options.seed ? options.seed : static_cast<unsigned>(time(nullptr));
+		srand(seed);
 		Renderer::Instance().Init(C_WIDTH, C_HEIGHT, "Asteroids OOP");
+		Renderer::Instance().SetSorting(options.sortDraws);
+		SetRandomSeed(seed);
+		AudioEngine::Instance().Init();
+		BulletPatterns::Instance().Compile();
+		if (options.patternEmitters > 0) {
+			BulletPatterns::Instance().Benchmark(options.patternEmitters, 10.f);
+		}
 
-		auto player = std::make_unique<PlayerShip>(C_WIDTH, C_HEIGHT);
+		// Fixed length runs are benchmarks, do not sleep between frames
+		std::vector<FrameSample> samples;
+		if (options.frames > 0) {
+			Renderer::Instance().LimitFps(0);
+			samples.reserve(options.frames);
+		}
+		int frame = 0;
+
+		AllocTracker& alloc = AllocTracker::Instance();
+		alloc.AttachGameThread();
+		alloc.MarkTransition();
+		bool showAllocStats = false;
+		bool showRenderStats = false;
+
+		FrameGovernor& governor = FrameGovernor::Instance();
+		governor.Configure(options.frameBudgetMs / 1000.0, options.maxGovernorLevel);
+		governor.Reset();
+		auto phase = [&alloc, &governor](FramePhase p) {
+			alloc.Phase(p);
+			governor.Phase(p);
+		};
 
-		float spawnTimer = 0.f;
-		float spawnInterval = Utils::RandomFloat(C_SPAWN_MIN, C_SPAWN_MAX);
+		const Rectangle worldBounds = { 0.f, 0.f, World::C_SIZE, World::C_SIZE };
+		const int worldSize = World::C_SECTOR_SIZE * World::C_SECTORS;
+		auto player = std::make_unique<PlayerShip>(worldSize, worldSize);
+		world.Generate(options.worldRocks, player->GetPosition(), C_CLEAR_RADIUS);
+
+		TimerWheel& timers = TimerWheel::Instance();
+		ScheduleSpawn();
 		WeaponType currentWeapon = WeaponType::LASER;
 		float shotTimer = 0.f;
 
-		while (!WindowShouldClose()) {
-			float dt = GetFrameTime();
-			spawnTimer += dt;
+		while (!WindowShouldClose() && (options.frames == 0 || frame < options.frames)) {
+			alloc.BeginFrame();
+			governor.BeginFrame();
+			double frameStart = GetTime();
+			float dt = (options.fixedDt > 0.f) ? options.fixedDt : GetFrameTime();
+
+			if (options.autopilot) {
+				PlayAutopilot(frame, *player);
+			}
 
 			if (IsKeyPressed(KEY_P) && player->IsAlive()) {
 				if (isPaused) {
@@ -484,18 +2960,29 @@ public:
 			// Update player
 			if (!isPaused) {
 				player->Update(dt);
+				player->Confine(worldBounds);
 			}
+			aimTarget = player->GetPosition();
 
 			// Restart logic
 			if (!player->IsAlive() && IsKeyPressed(KEY_R)) {
-				player = std::make_unique<PlayerShip>(C_WIDTH, C_HEIGHT);
-				asteroids.clear();
-				projectiles.clear();
-				aprojectiles.clear();
-				consumables.clear();
-				spawnTimer = 0.f;
-				spawnInterval = Utils::RandomFloat(C_SPAWN_MIN, C_SPAWN_MAX);
+				alloc.MarkTransition();
+				player = std::make_unique<PlayerShip>(worldSize, worldSize);
+				// The world is kept, live asteroids go back into it
+				world.Restart();
+				for (const auto& a : asteroids) {
+					world.Store(a->ToRock());
+				}
+				world.ClearArea(player->GetPosition(), C_CLEAR_RADIUS);
+				asteroids.Clear();
+				projectiles.Clear();
+				aprojectiles.Clear();
+				ClearConsumables();
+				timers.Clear();
+				ScheduleSpawn();
 			}
+			Renderer::Instance().Follow(player->GetPosition(), worldBounds);
+			FollowShotArea(Renderer::Instance().View());
 			// Asteroid shape switch
 			if (IsKeyPressed(KEY_ONE)) {
 				currentShape = AsteroidShape::TRIANGLE;
@@ -519,6 +3006,34 @@ public:
 				currentWeapon = static_cast<WeaponType>((static_cast<int>(currentWeapon) + 1) % static_cast<int>(WeaponType::COUNT));
 			}
 
+			if (IsKeyPressed(KEY_F1)) {
+				showAllocStats = !showAllocStats;
+			}
+			if (IsKeyPressed(KEY_F2)) {
+				showRenderStats = !showRenderStats;
+			}
+			if (IsKeyPressed(KEY_F3)) {
+				alloc.MarkTransition();
+				if (Renderer::Instance().IsDumpingStats()) {
+					Renderer::Instance().StopStatsDump();
+				}
+				else {
+					Renderer::Instance().StartStatsDump("render_stats.csv");
+				}
+			}
+			if (IsKeyPressed(KEY_F4) || (options.recordAtStart && frame == 0)) {
+				alloc.MarkTransition();
+				FrameRecorder& rec = FrameRecorder::Instance();
+				if (rec.IsRecording()) {
+					rec.Stop();
+				}
+				else {
+					rec.Start(C_WIDTH, C_HEIGHT, options.recordFormat, options.recordPrefix);
+				}
+			}
+
+			phase(FramePhase::SPAWN);
+
 			// Shooting
 			{
 				if (player->IsAlive() && IsKeyDown(KEY_SPACE) && !isPaused) {
@@ -529,7 +3044,10 @@ public:
 					while (shotTimer >= interval) {
 						Vector2 p = player->GetPosition();
 						p.y -= player->GetRadius();
-						projectiles.push_back(MakeProjectile(currentWeapon, p, 0.f, projSpeed));
+						if (projectiles.Size() < C_MAX_PROJECTILES) {
+							projectiles.Push(MakeProjectile(currentWeapon, p, 0.f, projSpeed, gameTime, shotArea));
+							AudioEngine::Instance().Post((currentWeapon == WeaponType::LASER) ? Sfx::LASER : Sfx::BULLET, p.x);
+						}
 						shotTimer -= interval;
 					}
 				}
@@ -542,159 +3060,175 @@ public:
 				}
 			}
 
-			// Spawn asteroids
-			if (spawnTimer >= spawnInterval && asteroids.size() < MAX_AST && !isPaused) {
-				asteroids.push_back(MakeAsteroid(C_WIDTH, C_HEIGHT, currentShape));
-				spawnTimer = 0.f;
-				spawnInterval = Utils::RandomFloat(C_SPAWN_MIN, C_SPAWN_MAX);
-			}
-
-			for (auto pait = asteroids.begin(); pait != asteroids.end(); ++pait) {
-				if ((*pait)->doesShoot() && !isPaused) {
-					float bullets = (*pait)->GetBullets();
-					if (bullets>0 && bullets - floorf(bullets) > 1-0.5*dt) {
-						Vector2 ap = (*pait)->GetPosition();
-						float r = (*pait)->GetRadius();
-						ap.y -= r;
-						WeaponType wptp = (*pait)->getWeapon();
-						float prspd = 0.f;
-						(wptp == WeaponType::LASER) ? prspd = 720.f : prspd = 440.f;
-						aprojectiles.push_back(MakeProjectile(wptp, ap, 0.f, prspd));
-						ap.y += 2 * r;
-						aprojectiles.push_back(MakeProjectile(wptp, ap, 0.f, -prspd));
-						ap.y -= r;
-						ap.x -= r;
-						aprojectiles.push_back(MakeProjectile(wptp, ap, -prspd, 0.f));
-						ap.x += 2 * r;
-						aprojectiles.push_back(MakeProjectile(wptp, ap, prspd, 0.f));
-					}
-					(*pait)->SetBullets(0.5*dt);
-
-				}
+			// Spawns, volleys and despawns fire from the wheel, game time stands still while paused
+			if (!isPaused) {
+				gameTime += dt;
+				timers.Advance(dt);
 			}
 
-			// Update projectiles - check if in boundries and move them forward
-			{
-				auto projectile_to_remove = std::remove_if(projectiles.begin(), projectiles.end(),
-					[dt](auto& projectile) {
-						return projectile.Update(dt);
-					});
-				projectiles.erase(projectile_to_remove, projectiles.end());
+			// Render benchmark scene: the view stays full of shooting hexagons and pickups
+			if (options.denseScene && !isPaused) {
+				PopulateDense();
 			}
 
+			// Sectors around the camera, rocks entering the active area become asteroids
+			double worldStart = GetTime();
 			{
-				auto aprojectile_to_remove = std::remove_if(aprojectiles.begin(), aprojectiles.end(),
-					[dt](auto& aprojectile) {
-						return aprojectile.Update(dt);
-					});
-				aprojectiles.erase(aprojectile_to_remove, aprojectiles.end());
+				Rectangle view = Renderer::Instance().View();
+				world.Update({ view.x + view.width * 0.5f, view.y + view.height * 0.5f }, isPaused ? 0.f : dt,
+					(asteroids.Size() < C_MAX_ASTEROIDS) ? C_MAX_ASTEROIDS - asteroids.Size() : 0);
+				for (const Rock& rock : world.Woken()) {
+					AddAsteroid(MakeAsteroid(rock));
+				}
+				world.ClearWoken();
+				// Exit times are planned against the active area, replan when the camera changes sector
+				Rectangle area = world.ActiveArea();
+				if (area.x != activeArea.x || area.y != activeArea.y || area.width != activeArea.width ||
+					area.height != activeArea.height) {
+					activeArea = area;
+					for (auto& a : asteroids) {
+						a->PlanExit(area);
+					}
+					asteroids.Rebuild();
+				}
 			}
+			double worldSeconds = GetTime() - worldStart;
+
+			phase(FramePhase::UPDATE);
+
+			// Positions are evaluated from game time, only what has left its area is touched
+			projectiles.RetireUntil(gameTime);
+			aprojectiles.RetireUntil(gameTime);
+			asteroids.RetireUntil(gameTime, [this](const auto& a) { world.Store(a->ToRock()); });
+
+			phase(FramePhase::COLLISION);
+			double collideStart = GetTime();
 
 			// Projectile-Asteroid collisions O(n^2)
-			for (auto pit = projectiles.begin(); pit != projectiles.end();) {
+			for (size_t pi = 0; pi < projectiles.Size();) {
 				bool removed = false;
-
-				for (auto ait = asteroids.begin(); ait != asteroids.end(); ++ait) {
-					float dist = Vector2Distance((*pit).GetPosition(), (*ait)->GetPosition());
-					if (dist < (*pit).GetRadius() + (*ait)->GetRadius()) {
-						ait = asteroids.erase(ait);
-						pit = projectiles.erase(pit);
+				Vector2 ppos = projectiles[pi].GetPosition();
+				float pradius = projectiles[pi].GetRadius();
+
+				for (size_t ai = 0; ai < asteroids.Size(); ++ai) {
+					const Asteroid& ast = *asteroids[ai];
+					if (Collides(ast, ppos, pradius)) {
+						int damage = ast.GetDamage();
+						Vector2 apos = ast.GetPosition();
+						Sfx boom = (ast.GetSize() == Renderable::LARGE) ? Sfx::EXPLOSION_LARGE :
+							(ast.GetSize() == Renderable::MEDIUM) ? Sfx::EXPLOSION_MEDIUM : Sfx::EXPLOSION_SMALL;
+						AudioEngine::Instance().Post(boom, apos.x);
+						asteroids.Remove(ai);
+						projectiles.Remove(pi);
 						int rnd = GetRandomValue(0, 100);
 						if (rnd > 70) {
-							consumables.push_back(Consumable((*ait)->GetDamage(), (*ait)->GetPosition()));
+							SpawnConsumable(damage, apos);
 						}
-						player->addScore((*ait)->GetDamage());
+						player->addScore(damage);
 						removed = true;
 						break;
 					}
 				}
 				if (!removed) {
-					++pit;
+					++pi;
 				}
 			}
 
 			// Projectile-Player collision
-			for (auto apit = aprojectiles.begin(); apit != aprojectiles.end();) {
+			for (size_t api = 0; api < aprojectiles.Size();) {
 				bool aremoved = false;
 
-				float adist = Vector2Distance((*apit).GetPosition(), player->GetPosition());
-				if (adist < (*apit).GetRadius() + player->GetRadius()) {
-					apit = aprojectiles.erase(apit);
-					player->TakeDamage((*apit).GetDamage());
+				float adist = Vector2Distance(aprojectiles[api].GetPosition(), player->GetPosition());
+				if (adist < aprojectiles[api].GetRadius() + player->GetRadius()) {
+					int damage = aprojectiles[api].GetDamage();
+					AudioEngine::Instance().Post(Sfx::PLAYER_HIT, player->GetPosition().x);
+					aprojectiles.Remove(api);
+					player->TakeDamage(damage);
 					aremoved = true;
 					break;
 				}
 				if (!aremoved) {
-					++apit;
+					++api;
 				}
 			}
 
 			// Consumable-Player collision
-			for (auto cpit = consumables.begin(); cpit != consumables.end();) {
-				bool cremoved = false;
-				if (!isPaused) {
-					(*cpit).addLifeTime(dt);
-				}
-				float cdist = Vector2Distance((*cpit).getPosition(), player->GetPosition());
+			for (uint32_t slot = 0; slot < C_MAX_CONSUMABLES; ++slot) {
+				Consumable& cons = consumables[slot];
+				if (!cons.IsActive()) continue;
+				float cdist = Vector2Distance(cons.getPosition(), player->GetPosition());
 				if (cdist < 5 + player->GetRadius()) {
-					cpit = consumables.erase(cpit);
-					player->TakeDamage(-(*cpit).getValue());
-					cremoved = true;
+					int heal = cons.getValue();
+					AudioEngine::Instance().Post(Sfx::PICKUP, player->GetPosition().x);
+					timers.Cancel(cons.getExpiry());
+					RemoveConsumable(slot);
+					player->TakeDamage(-heal);
 					break;
 				}
-				if ((*cpit).getLifeTime() > 5) {
-					cpit = consumables.erase(cpit);
-					cremoved = true;
-					break;
-				}
-				if (!cremoved) {
-					++cpit;
-				}
 			}
 
 			// Asteroid-Ship collisions
 			{
 				auto remove_collision =
-					[&player, dt](auto& asteroid_ptr_like) -> bool {
+					[this, &player](auto& asteroid_ptr_like) -> bool {
 					if (player->IsAlive()) {
-						float dist = Vector2Distance(player->GetPosition(), asteroid_ptr_like->GetPosition());
-
-						if (dist < player->GetRadius() + asteroid_ptr_like->GetRadius()) {
+						if (Collides(*asteroid_ptr_like, player->GetPosition(), player->GetRadius())) {
 							player->TakeDamage(asteroid_ptr_like->GetDamage());
+							AudioEngine::Instance().Post(Sfx::PLAYER_HIT, player->GetPosition().x);
 							return true; // Mark asteroid for removal due to collision
 						}
 					}
-					if (!asteroid_ptr_like->Update(dt)) {
-						return true;
-					}
 					return false; // Keep the asteroid
 					};
-				auto asteroid_to_remove = std::remove_if(asteroids.begin(), asteroids.end(), remove_collision);
-				asteroids.erase(asteroid_to_remove, asteroids.end());
+				for (size_t ai = 0; ai < asteroids.Size();) {
+					if (remove_collision(asteroids[ai])) {
+						asteroids.Remove(ai);
+					}
+					else {
+						++ai;
+					}
+				}
 			}
 
+			double collideSeconds = GetTime() - collideStart;
+			phase(FramePhase::AUDIO);
+			AudioEngine::Instance().Flush();
+
 			// Render everything
+			phase(FramePhase::RENDER);
+			double renderStart = GetTime();
 			{
 				Renderer::Instance().Begin();
 
+				Rectangle view = Renderer::Instance().View();
 				for (const auto& projPtr : projectiles) {
-					projPtr.Draw();
+					projPtr.Draw(view);
 				}
 				for (const auto& aprojPtr : aprojectiles) {
-					aprojPtr.Draw();
+					aprojPtr.Draw(view);
 				}
 				for (const auto& astPtr : asteroids) {
-					astPtr->Draw();
+					if (CheckCollisionCircleRec(astPtr->GetPosition(), astPtr->GetRadius(), view)) {
+						astPtr->Draw();
+					}
 				}
 				for (const auto& consPtr : consumables) {
-					consPtr.Draw();
+					if (consPtr.IsActive()) consPtr.Draw();
 				}
 
 				player->Draw();
+				// HUD is drawn immediately, on top of the world
+				Renderer::Instance().EndWorld();
 
-				const char* fpsc = TextFormat("FPS: %d", GetFPS());
+				// Fixed step runs show the simulated rate so dumped frames stay comparable
+				int fps = (options.fixedDt > 0.f) ? static_cast<int>(1.f / options.fixedDt + 0.5f) : GetFPS();
+				const char* fpsc = TextFormat("FPS: %d", fps);
 				int fpscs = MeasureText(fpsc, 20);
 				DrawText(fpsc, C_WIDTH - fpscs - 10, 10, 20, RED);
+				if (governor.Level() != GovernorLevel::FULL) {
+					const char* govc = TextFormat("Load: %s", GOVERNOR_LEVEL_NAMES[static_cast<int>(governor.Level())]);
+					DrawText(govc, C_WIDTH - MeasureText(govc, 20) - 10, 40, 20, ORANGE);
+				}
 
 				if (player->IsAlive()) {
 					DrawText(TextFormat("HP: %d", player->GetHP()),
@@ -729,7 +3263,9 @@ public:
 					const char* h4 = "4 - Change asteroid shape to hexagon";
 					const char* h5 = "5 - Change asteroid shape to random";
 					const char* h6 = "TAB - change weapon";
-					const char* h7 = "ESC - exit";
+					const char* h7 = "F1 - allocation stats";
+					const char* h8 = "F2 - render stats, F3 - dump render stats to file, F4 - record";
+					const char* h9 = "ESC - exit";
 					DrawText(h0, (C_WIDTH - MeasureText(h0, 40)) / 2, 120, 40, PURPLE);
 					DrawText(h1, (C_WIDTH - MeasureText(h1, 20)) / 2, 180, 20, PURPLE);
 					DrawText(h2, (C_WIDTH - MeasureText(h2, 20)) / 2, 210, 20, PURPLE);
@@ -738,41 +3274,382 @@ public:
 					DrawText(h5, (C_WIDTH - MeasureText(h5, 20)) / 2, 300, 20, PURPLE);
 					DrawText(h6, (C_WIDTH - MeasureText(h6, 20)) / 2, 330, 20, PURPLE);
 					DrawText(h7, (C_WIDTH - MeasureText(h7, 20)) / 2, 360, 20, PURPLE);
+					DrawText(h8, (C_WIDTH - MeasureText(h8, 20)) / 2, 390, 20, PURPLE);
+					DrawText(h9, (C_WIDTH - MeasureText(h9, 20)) / 2, 420, 20, PURPLE);
+				}
+
+				if (showAllocStats) {
+					DrawAllocStats(alloc);
+				}
+				if (showRenderStats) {
+					Renderer::Instance().DrawStats(C_WIDTH - 560, C_HEIGHT - 90);
+				}
+
+				if (options.dumpEvery > 0 && frame % options.dumpEvery == 0) {
+					Renderer::Instance().Capture(TextFormat("%s_%05d.png", options.dumpPrefix, frame));
 				}
 
 				Renderer::Instance().End();
 			}
+			alloc.EndFrame();
+			governor.EndFrame(Renderer::Instance().LimiterSeconds());
+
+			if (options.frames > 0) {
+				const Renderer& r = Renderer::Instance();
+				samples.push_back({ renderStart - frameStart, collideSeconds, worldSeconds, r.RecordSeconds(), r.SubmitSeconds(),
+					GetTime() - frameStart, r.Stats().drawCalls, r.Stats().vertices,
+					static_cast<int>(asteroids.Size()), world.Ticked() });
+			}
+			frame++;
+		}
+
+		if (options.frames > 0) {
+			ReportBenchmark(samples);
+		}
+
+		if (options.frames > 0 && FrameRecorder::Instance().IsRecording()) {
+			printf("BENCH capture %d frames, %d dropped\n", FrameRecorder::Instance().Captured(),
+				FrameRecorder::Instance().Dropped());
 		}
+		alloc.Report();
+		alloc.MarkTransition();
+		FrameRecorder::Instance().Stop();
+		asteroids.Clear();
+		ClearConsumables();
+		timers.Clear();
+		Renderer::Instance().StopStatsDump();
+		AudioEngine::Instance().Shutdown();
 	}
 
 private:
+	struct FrameSample {
+		double update;     // simulation, everything before rendering
+		double collide;    // collision phase, part of update
+		double world;      // sector ticking and waking, part of update
+		double record;     // issuing draw calls
+		double submit;     // EndDrawing(): batch flush, swap
+		double total;
+		int drawCalls;
+		int vertices;
+		int asteroids;     // live, in the active sectors
+		int rocksTicked;   // stored rocks advanced by the world
+	};
+
+	void ScheduleSpawn() {
+		float scale = FrameGovernor::Instance().Applies(GovernorLevel::SPAWNS) ? C_THROTTLED_SPAWN_SCALE : 1.f;
+		TimerWheel::Instance().Schedule(scale * Utils::RandomFloat(C_SPAWN_MIN, C_SPAWN_MAX), OnSpawnTimer, this, 0);
+	}
+
+	// The camera may drift up to a step from the view the area was built around, the rest of the
+	// margin covers it so shots on screen are never retired
+	void FollowShotArea(const Rectangle& view) {
+		float dx = fabsf(view.x - (shotArea.x + C_SHOT_MARGIN));
+		float dy = fabsf(view.y - (shotArea.y + C_SHOT_MARGIN));
+		if (shotArea.width > 0.f && dx < C_SHOT_REPLAN_STEP && dy < C_SHOT_REPLAN_STEP) return;
+		shotArea = { view.x - C_SHOT_MARGIN, view.y - C_SHOT_MARGIN, view.width + 2.f * C_SHOT_MARGIN,
+			view.height + 2.f * C_SHOT_MARGIN };
+		for (auto& p : projectiles) {
+			p.PlanExit(shotArea, gameTime);
+		}
+		projectiles.Rebuild();
+		for (auto& p : aprojectiles) {
+			p.PlanExit(shotArea, gameTime);
+		}
+		aprojectiles.Rebuild();
+	}
+
+	void AddAsteroid(std::unique_ptr<Asteroid> a) {
+		a->PlanExit(activeArea);
+		if (a->doesShoot()) {
+			BulletPatterns::Instance().Start(a->Emitter(), a->GetPattern());
+			a->SetEmitterTimer(TimerWheel::Instance().Schedule(0.f, OnEmitterTimer, this,
+				reinterpret_cast<uintptr_t>(a.get())));
+		}
+		asteroids.Push(std::move(a));
+	}
+
+	static void OnSpawnTimer(void* ctx, uintptr_t) {
+		Application* app = static_cast<Application*>(ctx);
+		if (app->asteroids.Size() < MAX_AST) {
+			app->AddAsteroid(MakeAsteroid(Renderer::Instance().View(), app->currentShape));
+		}
+		app->ScheduleSpawn();
+	}
+
+	// Runs the asteroid's bullet pattern up to its next wait, the asteroid cancels its timer when destroyed
+	static void OnEmitterTimer(void* ctx, uintptr_t arg) {
+		Application* app = static_cast<Application*>(ctx);
+		Asteroid& a = *reinterpret_cast<Asteroid*>(arg);
+		EmitContext emit{ a.GetPosition(), a.GetRadius(), app->aimTarget, a.getWeapon(), gameTime, app->shotArea };
+		size_t before = app->aprojectiles.Size();
+		size_t cap = FrameGovernor::Instance().Applies(GovernorLevel::ENEMY_FIRE) ? C_GOVERNED_APROJECTILES :
+			C_MAX_APROJECTILES;
+		BulletPatterns& patterns = BulletPatterns::Instance();
+		float wait = patterns.Run(a.Emitter(), emit, (cap > before) ? cap - before : 0);
+		app->aprojectiles.Append(patterns.LastVolley());
+		if (app->aprojectiles.Size() > before) {
+			AudioEngine::Instance().Post((emit.weapon == WeaponType::LASER) ? Sfx::ENEMY_LASER : Sfx::ENEMY_BULLET,
+				emit.origin.x);
+		}
+		a.SetEmitterTimer((wait < 0.f) ? 0 : TimerWheel::Instance().Schedule(wait, OnEmitterTimer, ctx, arg));
+	}
+
+	void PopulateDense() {
+		Rectangle view = Renderer::Instance().View();
+		auto inView = [&view]() {
+			return Vector2{ view.x + Utils::RandomFloat(0.f, view.width), view.y + Utils::RandomFloat(0.f, view.height) };
+		};
+		while (asteroids.Size() < C_DENSE_ASTEROIDS) {
+			Rock rock = Asteroid::RandomRock(inView());
+			rock.sides = 6;
+			AddAsteroid(MakeAsteroid(rock));
+		}
+		while (!freeConsumables.empty()) {
+			SpawnConsumable(20, inView());
+		}
+	}
+
+	// The timer carries the slot, a pickup cancels it before the slot can be reused
+	static void OnConsumableExpired(void* ctx, uintptr_t arg) {
+		static_cast<Application*>(ctx)->RemoveConsumable(static_cast<uint32_t>(arg));
+	}
+
+	void SpawnConsumable(int value, Vector2 pos) {
+		if (freeConsumables.empty()) return;
+		uint32_t slot = freeConsumables.back();
+		freeConsumables.pop_back();
+		consumables[slot] = Consumable(value, pos);
+		consumables[slot].setExpiry(TimerWheel::Instance().Schedule(C_CONSUMABLE_LIFE, OnConsumableExpired, this, slot));
+	}
+
+	void RemoveConsumable(uint32_t slot) {
+		consumables[slot] = Consumable();
+		freeConsumables.push_back(slot);
+	}
+
+	void ClearConsumables() {
+		freeConsumables.clear();
+		for (uint32_t slot = C_MAX_CONSUMABLES; slot-- > 0;) {
+			consumables[slot] = Consumable();
+			freeConsumables.push_back(slot);
+		}
+	}
+
+	bool Collides(const Asteroid& a, Vector2 c, float r) const {
+		if (options.circleHits) return a.BoundsOverlap(c, r);
+		// Away from the player a near miss is not noticeable, bounding circles do while shedding load
+		if (FrameGovernor::Instance().Applies(GovernorLevel::COLLISION) &&
+			Vector2DistanceSqr(c, aimTarget) > C_PRECISE_RADIUS * C_PRECISE_RADIUS) {
+			return a.BoundsOverlap(c, r);
+		}
+		return a.Hits(c, r);
+	}
+
+	// Scripted input for unattended runs, fed through raylib automation events: fire, strafe, fly up every other 10 s
+	void PlayAutopilot(int frame, const PlayerShip& player) const {
+		auto key = [](int k, bool down) {
+			AutomationEvent ev{};
+			ev.type = down ? C_EVENT_KEY_DOWN : C_EVENT_KEY_UP;
+			ev.params[0] = k;
+			PlayAutomationEvent(ev);
+		};
+		bool left = (frame / 90) % 2 == 0;
+		key(KEY_SPACE, true);
+		key(KEY_FIVE, frame == 0);
+		key(KEY_TAB, frame > 0 && frame % 240 == 0);
+		key(KEY_A, left);
+		key(KEY_D, !left);
+		key(KEY_W, (frame / 600) % 2 == 1);
+		key(KEY_R, !player.IsAlive());
+	}
+
+	void ReportBenchmark(std::vector<FrameSample>& samples) const {
+		if (samples.empty()) return;
+		auto report = [&samples](const char* name, double FrameSample::* field) {
+			std::sort(samples.begin(), samples.end(),
+				[field](const FrameSample& a, const FrameSample& b) { return a.*field < b.*field; });
+			double sum = 0.0;
+			for (const FrameSample& fs : samples) sum += fs.*field;
+			size_t n = samples.size();
+			printf("BENCH %-7s avg %8.3f ms  p50 %8.3f ms  p95 %8.3f ms  max %8.3f ms\n", name,
+				1000.0 * sum / n, 1000.0 * (samples[n / 2].*field), 1000.0 * (samples[n * 95 / 100].*field),
+				1000.0 * (samples[n - 1].*field));
+		};
+		long long drawCalls = 0;
+		long long vertices = 0;
+		for (const FrameSample& fs : samples) {
+			drawCalls += fs.drawCalls;
+			vertices += fs.vertices;
+		}
+		printf("BENCH frames %d, avg %.1f draw calls, %.0f vertices per frame\n", static_cast<int>(samples.size()),
+			static_cast<double>(drawCalls) / samples.size(), static_cast<double>(vertices) / samples.size());
+		printf("BENCH collision %s\n", options.circleHits ? "bounding circles" : "exact polygons");
+		const FrameGovernor& governor = FrameGovernor::Instance();
+		if (governor.Budget() > 0.0) {
+			printf("BENCH governor budget %.2f ms, %d level changes, frames per level", 1000.0 * governor.Budget(),
+				governor.Changes());
+			for (int i = 0; i < static_cast<int>(GovernorLevel::COUNT); ++i) {
+				printf(" %d", governor.FramesAt(static_cast<GovernorLevel>(i)));
+			}
+			printf(", ends at '%s' (%s)\n", GOVERNOR_LEVEL_NAMES[static_cast<int>(governor.Level())], governor.Reason());
+		}
+		else {
+			printf("BENCH governor off\n");
+		}
+		long long live = 0;
+		long long ticked = 0;
+		for (const FrameSample& fs : samples) {
+			live += fs.asteroids;
+			ticked += fs.rocksTicked;
+		}
+		printf("BENCH world %zu stored rocks, avg %.1f live asteroids, %.1f rocks ticked per frame\n", world.Stored(),
+			static_cast<double>(live) / samples.size(), static_cast<double>(ticked) / samples.size());
+		report("update", &FrameSample::update);
+		report("collide", &FrameSample::collide);
+		report("world", &FrameSample::world);
+		report("record", &FrameSample::record);
+		report("submit", &FrameSample::submit);
+		report("total", &FrameSample::total);
+	}
+
 	Application()
 	{
-		asteroids.reserve(1000);
-		projectiles.reserve(10'000);
-		aprojectiles.reserve(10'000);
+		asteroids.Reserve(C_MAX_ASTEROIDS);
+		projectiles.Reserve(C_MAX_PROJECTILES);
+		aprojectiles.Reserve(C_MAX_APROJECTILES);
+		consumables.resize(C_MAX_CONSUMABLES);
+		freeConsumables.reserve(C_MAX_CONSUMABLES);
+		ClearConsumables();
 	};
 
-	std::vector<std::unique_ptr<Asteroid>> asteroids;
-	std::vector<Projectile> projectiles;
-	std::vector<Projectile> aprojectiles;
-	std::vector<Consumable> consumables;
+	void DrawAllocStats(const AllocTracker& alloc) const {
+		const AllocCounters& f = alloc.LastFrame();
+		int y = C_HEIGHT - 30 - 20 * static_cast<int>(FramePhase::COUNT) - 40;
+		DrawText(TextFormat("Alloc%s: %llu (%llu B) free %llu%s", ALLOC_TRACKING ? "" : " (tracking off)",
+			static_cast<unsigned long long>(f.allocs), static_cast<unsigned long long>(f.bytes),
+			static_cast<unsigned long long>(f.frees), alloc.IsSteady() ? "" : " [warmup]"), 10, y, 20, YELLOW);
+		y += 20;
+		DrawText(TextFormat("Heap: %lld KB, frame peak %lld KB, peak %lld KB",
+			static_cast<long long>(alloc.LiveBytes() / 1024), static_cast<long long>(alloc.LastFramePeakBytes() / 1024),
+			static_cast<long long>(alloc.PeakBytes() / 1024)), 10, y, 20, YELLOW);
+		y += 20;
+		for (int i = 0; i < static_cast<int>(FramePhase::COUNT); ++i) {
+			const AllocCounters& c = alloc.LastPhase(static_cast<FramePhase>(i));
+			DrawText(TextFormat("  %-10s %llu (%llu B) peak %lld KB", FRAME_PHASE_NAMES[i],
+				static_cast<unsigned long long>(c.allocs), static_cast<unsigned long long>(c.bytes),
+				static_cast<long long>(c.peak / 1024)), 10, y, 20, YELLOW);
+			y += 20;
+		}
+	}
+
+	ExitQueue<std::unique_ptr<Asteroid>, AsteroidExit> asteroids;
+	ExitQueue<Projectile, ProjectileExit> projectiles;
+	ExitQueue<Projectile, ProjectileExit> aprojectiles;
+	std::vector<Consumable> consumables;       // fixed slots, expiry timers refer to them by index
+	std::vector<uint32_t> freeConsumables;
+	World world;
 
 	AsteroidShape currentShape = AsteroidShape::TRIANGLE;
+	RunOptions options;
+	Vector2 aimTarget{};              // where aimed bullet patterns shoot at
+	Rectangle activeArea{};           // asteroid exit times are planned against it
+	Rectangle shotArea{};             // projectile exit times are planned against it
+
+	// AutomationEventType values from rcore.c
+	static constexpr unsigned int C_EVENT_KEY_UP = 1;
+	static constexpr unsigned int C_EVENT_KEY_DOWN = 2;
 
 	static constexpr int C_WIDTH = 1000;
 	static constexpr int C_HEIGHT = 1000;
 	static constexpr size_t MAX_AST = 150;
+	static constexpr float C_CLEAR_RADIUS = 1500.f;
 	static constexpr float C_SPAWN_MIN = 0.5f;
 	static constexpr float C_SPAWN_MAX = 3.0f;
-
-	static constexpr int C_MAX_ASTEROIDS = 1000;
-	static constexpr int C_MAX_PROJECTILES = 10'000;
-	static constexpr int C_MAX_APROJECTILES = 10'000;
-	static constexpr int C_MAX_CONSUMABLES = 100;
+	static constexpr float C_CONSUMABLE_LIFE = 5.f;
+
+	static constexpr size_t C_MAX_ASTEROIDS = 1000;
+	static_assert(C_MAX_ASTEROIDS <= Asteroid::C_POOL_SIZE, "live asteroids must fit the pool");
+	static constexpr size_t C_MAX_PROJECTILES = 10'000;
+	static constexpr size_t C_MAX_APROJECTILES = 10'000;
+	static constexpr uint32_t C_MAX_CONSUMABLES = 100;
+	static constexpr size_t C_DENSE_ASTEROIDS = 300;
+
+	// Frame governor measures
+	static constexpr float C_THROTTLED_SPAWN_SCALE = 2.f;
+	static constexpr size_t C_GOVERNED_APROJECTILES = 1000;
+	static constexpr float C_PRECISE_RADIUS = 400.f;
+
+	// Shots live in the view plus a margin, replanned after the camera moves a step
+	static constexpr float C_SHOT_MARGIN = 300.f;
+	static constexpr float C_SHOT_REPLAN_STEP = 150.f;
 };
 
-int main() {
+int main(int argc, char** argv) {
+	RunOptions options;
+	bool budgetGiven = false;
+	for (int i = 1; i < argc; ++i) {
+		bool hasValue = i + 1 < argc;
+		// Debug aid: abort on any allocation in a steady-state frame
+		if (strcmp(argv[i], "-noalloc") == 0) {
+			AllocTracker::Instance().SetAssertSteady(true);
+		}
+		// Fixed length, deterministic run with scripted input and timing report
+		else if (strcmp(argv[i], "-bench") == 0 && hasValue) {
+			options.frames = atoi(argv[++i]);
+			options.fixedDt = 1.f / 60.f;
+			options.autopilot = true;
+			if (!options.seed) options.seed = 1;
+		}
+		else if (strcmp(argv[i], "-seed") == 0 && hasValue) {
+			options.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+		}
+		else if (strcmp(argv[i], "-dump") == 0 && hasValue) {
+			options.dumpEvery = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-dumpprefix") == 0 && hasValue) {
+			options.dumpPrefix = argv[++i];
+		}
+		else if (strcmp(argv[i], "-circlehits") == 0) {
+			options.circleHits = true;
+		}
+		else if (strcmp(argv[i], "-nosort") == 0) {
+			options.sortDraws = false;
+		}
+		// Record gameplay from the start: -record gif|qoi
+		else if (strcmp(argv[i], "-record") == 0 && hasValue) {
+			options.recordAtStart = true;
+			options.recordFormat = (strcmp(argv[++i], "qoi") == 0) ? FrameRecorder::Format::QOI : FrameRecorder::Format::GIF;
+		}
+		else if (strcmp(argv[i], "-recordprefix") == 0 && hasValue) {
+			options.recordPrefix = argv[++i];
+		}
+		// Frame budget in ms for the governor, 0 turns it off
+		else if (strcmp(argv[i], "-budget") == 0 && hasValue) {
+			options.frameBudgetMs = static_cast<float>(atof(argv[++i]));
+			budgetGiven = true;
+		}
+		// Highest degradation level the governor may use, 0-4
+		else if (strcmp(argv[i], "-governor") == 0 && hasValue) {
+			int level = std::clamp(atoi(argv[++i]), 0, static_cast<int>(GovernorLevel::COUNT) - 1);
+			options.maxGovernorLevel = static_cast<GovernorLevel>(level);
+		}
+		// Heavy scene for the draw sorting benchmark, combine with -bench and -nosort
+		else if (strcmp(argv[i], "-dense") == 0) {
+			options.denseScene = true;
+		}
+		// Emission rate of N bullet pattern emitters, printed before the run starts
+		else if (strcmp(argv[i], "-patternbench") == 0 && hasValue) {
+			options.patternEmitters = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-rocks") == 0 && hasValue) {
+			options.worldRocks = strtoul(argv[++i], nullptr, 10);
+		}
+	}
+	// Benchmarks compare fixed workloads, the governor would tie them to machine speed
+	if (options.frames > 0 && !budgetGiven) {
+		options.frameBudgetMs = 0.f;
+	}
+	Application::Instance().SetOptions(options);
 	Application::Instance().Run();
 	return 0;
 }
@@ -0,0 +1,27 @@
+#ifndef RL_ALLOC_HOOKS_H
+#define RL_ALLOC_HOOKS_H
+
+// Force-included into the debug raylib build (see build.bat) so every RL_MALLOC/RL_FREE
+// goes through the allocation tracker in Main.cpp
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *TrackedMalloc(size_t size);
+void *TrackedCalloc(size_t count, size_t size);
+void *TrackedRealloc(void *ptr, size_t size);
+void TrackedFree(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define RL_MALLOC(sz)       TrackedMalloc(sz)
+#define RL_CALLOC(n,sz)     TrackedCalloc(n,sz)
+#define RL_REALLOC(ptr,sz)  TrackedRealloc(ptr,sz)
+#define RL_FREE(ptr)        TrackedFree(ptr)
+
+#endif // RL_ALLOC_HOOKS_H